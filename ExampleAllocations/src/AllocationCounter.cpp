@@ -0,0 +1,57 @@
+//
+//  AllocationCounter.cpp
+//
+
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+	std::atomic<std::size_t> sNumAllocations{ 0 };
+	std::atomic<std::size_t> sNumFrees{ 0 };
+	std::atomic<std::size_t> sNumBytes{ 0 };
+	
+	void* sAllocate( std::size_t aSize ) {
+		sNumAllocations++;
+		sNumBytes += aSize;
+		void* tptr = std::malloc( aSize > 0 ? aSize : 1 );
+		if( !tptr ) {
+			throw std::bad_alloc();
+		}
+		return tptr;
+	}
+	
+	void sFree( void* aPtr ) {
+		if( aPtr ) {
+			sNumFrees++;
+			std::free( aPtr );
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void* operator new( std::size_t aSize ) { return sAllocate( aSize ); }
+void* operator new[]( std::size_t aSize ) { return sAllocate( aSize ); }
+void operator delete( void* aPtr ) noexcept { sFree( aPtr ); }
+void operator delete[]( void* aPtr ) noexcept { sFree( aPtr ); }
+void operator delete( void* aPtr, std::size_t ) noexcept { sFree( aPtr ); }
+void operator delete[]( void* aPtr, std::size_t ) noexcept { sFree( aPtr ); }
+
+//--------------------------------------------------------------
+AllocationCounter AllocationCounter::sGetTotals() {
+	AllocationCounter tcounter;
+	tcounter.numAllocations = sNumAllocations.load();
+	tcounter.numFrees = sNumFrees.load();
+	tcounter.numBytes = sNumBytes.load();
+	return tcounter;
+}
+
+//--------------------------------------------------------------
+AllocationCounter AllocationCounter::operator-( const AllocationCounter& aStart ) const {
+	AllocationCounter tcounter;
+	tcounter.numAllocations = numAllocations - aStart.numAllocations;
+	tcounter.numFrees = numFrees - aStart.numFrees;
+	tcounter.numBytes = numBytes - aStart.numBytes;
+	return tcounter;
+}
@@ -0,0 +1,21 @@
+//
+//  AllocationCounter.h
+//
+//  Counts the calls to the global operator new and operator delete of the whole app,
+//  replaced in AllocationCounter.cpp.
+//
+
+#pragma once
+#include <cstddef>
+
+class AllocationCounter {
+public:
+	std::size_t numAllocations = 0;
+	std::size_t numFrees = 0;
+	std::size_t numBytes = 0;
+	
+	// the totals since the app started
+	static AllocationCounter sGetTotals();
+	// the calls made since aStart
+	AllocationCounter operator-( const AllocationCounter& aStart ) const;
+};
@@ -0,0 +1,17 @@
+#include "ofMain.h"
+#include "ofApp.h"
+
+//========================================================================
+int main( ){
+
+	ofGLWindowSettings settings;
+	settings.setSize(1024, 768);
+	settings.setGLVersion(3,2);
+	settings.windowMode = OF_WINDOW;
+	
+	auto window = ofCreateWindow(settings);
+	
+	ofRunApp(window, std::make_shared<ofApp>());
+	ofRunMainLoop();
+
+}
@@ -0,0 +1,90 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofSetBackgroundColor(250);
+	ofSetFrameRate( 30 );
+	runBenchmark();
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	ofSetColor( 30 );
+	ofDrawBitmapString( mReport, 24, 32 );
+	ofDrawBitmapString( "space to run again, drop an svg file to measure it", 24, ofGetHeight() - 24 );
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	if( key == ' ' ) {
+		runBenchmark();
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){
+	for( auto& tfile : dragInfo.files ) {
+		if( ofToLower( ofFilePath::getFileExt( tfile )) == "svg" ) {
+			mSvgPath = tfile;
+			runBenchmark();
+			break;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::runBenchmark() {
+	// load once so the fonts, images and static caches do not count towards the first run
+	measure( false );
+	
+	auto tdefault = measure( false );
+	auto tarena = measure( true );
+	
+	mReport = mSvgPath.filename().string() + " : " + ofToString( tdefault.numElements ) + " elements, average of " + ofToString( mNumLoads ) + " loads\n\n";
+	mReport += toString( "std allocator", tdefault ) + "\n";
+	mReport += toString( "arena", tarena );
+	ofLogNotice("Allocations") << std::endl << mReport;
+}
+
+//--------------------------------------------------------------
+ofApp::Result ofApp::measure( bool abUseArena ) {
+	Result tresult;
+	for( int i = 0; i < mNumLoads; i++ ) {
+		auto tsvg = std::make_unique<ofx::svg::Parser>();
+		tsvg->setArenaAllocationEnabled( abUseArena );
+		tsvg->setAsyncImageLoading( false );
+		
+		auto tstart = AllocationCounter::sGetTotals();
+		uint64_t tstartMicros = ofGetElapsedTimeMicros();
+		tsvg->load( mSvgPath );
+		tresult.loadMicros += ofGetElapsedTimeMicros() - tstartMicros;
+		auto tloaded = AllocationCounter::sGetTotals();
+		tresult.numElements = tsvg->getMemoryStats( 0 ).numElements;
+		
+		auto treleaseStart = AllocationCounter::sGetTotals();
+		tsvg.reset();
+		auto treleased = AllocationCounter::sGetTotals();
+		
+		auto tload = tloaded - tstart;
+		auto trelease = treleased - treleaseStart;
+		tresult.load.numAllocations += tload.numAllocations;
+		tresult.load.numFrees += tload.numFrees;
+		tresult.load.numBytes += tload.numBytes;
+		tresult.release.numFrees += trelease.numFrees;
+	}
+	tresult.load.numAllocations /= mNumLoads;
+	tresult.load.numFrees /= mNumLoads;
+	tresult.load.numBytes /= mNumLoads;
+	tresult.release.numFrees /= mNumLoads;
+	tresult.loadMicros /= mNumLoads;
+	return tresult;
+}
+
+//--------------------------------------------------------------
+std::string ofApp::toString( const std::string& aLabel, const Result& aResult ) {
+	std::stringstream ss;
+	ss << aLabel << std::endl;
+	ss << "   load: " << aResult.load.numAllocations << " allocations, " << aResult.load.numFrees << " frees, " << aResult.load.numBytes << " bytes, " << aResult.loadMicros << " us" << std::endl;
+	ss << "   release: " << aResult.release.numFrees << " frees" << std::endl;
+	return ss.str();
+}
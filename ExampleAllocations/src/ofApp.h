@@ -0,0 +1,33 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxSvgParser.h"
+#include "AllocationCounter.h"
+
+// loads the same svg with and without arena allocation and reports the heap allocations
+// made while loading and while releasing the document.
+class ofApp : public ofBaseApp{
+	public:
+		void setup();
+		void draw();
+		
+		void keyPressed(int key);
+		void dragEvent(ofDragInfo dragInfo);
+	
+	protected:
+		class Result {
+		public:
+			AllocationCounter load;
+			AllocationCounter release;
+			uint64_t loadMicros = 0;
+			std::size_t numElements = 0;
+		};
+		
+		void runBenchmark();
+		Result measure( bool abUseArena );
+		std::string toString( const std::string& aLabel, const Result& aResult );
+	
+		of::filesystem::path mSvgPath = "ofLogoDesserts.svg";
+		int mNumLoads = 50;
+		std::string mReport;
+};
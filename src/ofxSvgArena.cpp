@@ -0,0 +1,67 @@
+//
+//  ofxSvgArena.cpp
+//
+
+#include "ofxSvgArena.h"
+#include <algorithm>
+#include <cstdint>
+
+using namespace ofx::svg;
+
+//--------------------------------------------------------------
+Arena::Arena( std::size_t aBlockSize ) {
+	mBlockSize = std::max( aBlockSize, (std::size_t)1024 );
+}
+
+//--------------------------------------------------------------
+Arena::~Arena() {
+	// all of the blocks are released together
+	mBlocks.clear();
+}
+
+//--------------------------------------------------------------
+void* Arena::allocate( std::size_t aSize, std::size_t aAlignment ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+	mNumAllocations++;
+	mNumLiveAllocations++;
+	mNumBytesUsed += aSize;
+
+	if( aSize > mBlockSize / 4 ) {
+		// large allocations get their own block, so the current block is not wasted
+		std::size_t tsize = aSize + aAlignment;
+		mBlocks.emplace_back( new unsigned char[ tsize ] );
+		mNumBytesReserved += tsize;
+		auto taddress = reinterpret_cast<std::uintptr_t>( mBlocks.back().get() );
+		taddress = ( taddress + aAlignment - 1 ) & ~( (std::uintptr_t)aAlignment - 1 );
+		return reinterpret_cast<void*>( taddress );
+	}
+
+	auto taddress = reinterpret_cast<std::uintptr_t>( mCurrent );
+	std::size_t tpadding = mCurrent ? ((( taddress + aAlignment - 1 ) & ~( (std::uintptr_t)aAlignment - 1 )) - taddress ) : 0;
+	if( !mCurrent || tpadding + aSize > mRemaining ) {
+		mBlocks.emplace_back( new unsigned char[ mBlockSize ] );
+		mNumBytesReserved += mBlockSize;
+		mCurrent = mBlocks.back().get();
+		mRemaining = mBlockSize;
+		taddress = reinterpret_cast<std::uintptr_t>( mCurrent );
+		// new[] is aligned for any fundamental type
+		tpadding = (( taddress + aAlignment - 1 ) & ~( (std::uintptr_t)aAlignment - 1 )) - taddress;
+	}
+	unsigned char* tptr = mCurrent + tpadding;
+	mCurrent = tptr + aSize;
+	mRemaining -= tpadding + aSize;
+	return tptr;
+}
+
+//--------------------------------------------------------------
+void Arena::deallocate( void* aPtr, std::size_t /*aSize*/ ) {
+	if( aPtr ) {
+		mNumLiveAllocations--;
+	}
+}
+
+//--------------------------------------------------------------
+std::size_t Arena::getNumBlocks() {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mBlocks.size();
+}
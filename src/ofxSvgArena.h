@@ -0,0 +1,84 @@
+//
+//  ofxSvgArena.h
+//
+//  Monotonic arena for the nodes of a parsed document. Allocations are carved out of large
+//  blocks and never freed one by one, the blocks are released together once the last
+//  element that was allocated from the arena is destroyed.
+//
+
+#pragma once
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <atomic>
+#include <string>
+
+namespace ofx::svg {
+class Arena : public std::enable_shared_from_this<Arena> {
+public:
+	template<typename T>
+	class Allocator {
+	public:
+		typedef T value_type;
+
+		Allocator( const std::shared_ptr<Arena>& aArena ) : mArena( aArena ) {}
+		template<typename U>
+		Allocator( const Allocator<U>& aOther ) : mArena( aOther.mArena ) {}
+
+		T* allocate( std::size_t aNum ) {
+			return static_cast<T*>( mArena->allocate( aNum * sizeof(T), alignof(T) ));
+		}
+		void deallocate( T* aPtr, std::size_t aNum ) {
+			mArena->deallocate( aPtr, aNum * sizeof(T) );
+		}
+
+		template<typename U>
+		bool operator==( const Allocator<U>& aOther ) const { return mArena == aOther.mArena; }
+		template<typename U>
+		bool operator!=( const Allocator<U>& aOther ) const { return mArena != aOther.mArena; }
+
+		// the copy stored in each shared_ptr control block keeps the arena alive
+		std::shared_ptr<Arena> mArena;
+	};
+
+	// allocations larger than a quarter of the block size get their own block
+	Arena( std::size_t aBlockSize = 64 * 1024 );
+	~Arena();
+	Arena( const Arena& ) = delete;
+	Arena& operator=( const Arena& ) = delete;
+
+	void* allocate( std::size_t aSize, std::size_t aAlignment );
+	// the memory is only returned when the arena is destroyed
+	void deallocate( void* aPtr, std::size_t aSize );
+
+	// the object and its shared_ptr control block are allocated together from the arena
+	template<typename T, typename... Args>
+	std::shared_ptr<T> makeShared( Args&&... aArgs ) {
+		return std::allocate_shared<T>( Allocator<T>( shared_from_this() ), std::forward<Args>(aArgs)... );
+	}
+
+	// allocations served by the arena
+	std::size_t getNumAllocations() { return mNumAllocations; }
+	// allocations that have not been deallocated yet
+	std::size_t getNumLiveAllocations() { return mNumLiveAllocations; }
+	// heap allocations made by the arena for its blocks
+	std::size_t getNumBlocks();
+	std::size_t getNumBytesUsed() { return mNumBytesUsed; }
+	std::size_t getNumBytesReserved() { return mNumBytesReserved; }
+
+	// will log messages to this module name
+	static const std::string moduleName() { return "ofx::svg::Arena"; }
+
+protected:
+	std::size_t mBlockSize = 64 * 1024;
+	std::vector< std::unique_ptr<unsigned char[]> > mBlocks;
+	unsigned char* mCurrent = nullptr;
+	std::size_t mRemaining = 0;
+	std::mutex mMutex;
+
+	std::size_t mNumAllocations = 0;
+	std::atomic<std::size_t> mNumLiveAllocations{ 0 };
+	std::size_t mNumBytesUsed = 0;
+	std::size_t mNumBytesReserved = 0;
+};
+}
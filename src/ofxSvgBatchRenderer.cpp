@@ -0,0 +1,349 @@
+//
+//  ofxSvgBatchRenderer.cpp
+//
+
+#include "ofxSvgBatchRenderer.h"
+#include "ofxSvgGroup.h"
+#include "ofxSvgSpatialIndex.h"
+#include "ofGraphics.h"
+
+using namespace ofx::svg;
+using std::vector;
+using std::shared_ptr;
+
+//--------------------------------------------------------------
+void BatchRenderer::build( Group& aRoot ) {
+	clear();
+	_collectRecursive( aRoot, aRoot.pos );
+	mBAnyDirty = mBatches.size() > 0;
+}
+
+//--------------------------------------------------------------
+void BatchRenderer::clear() {
+	mBatches.clear();
+	mBatchesForElement.clear();
+	mBAnyDirty = false;
+}
+
+//--------------------------------------------------------------
+bool BatchRenderer::markDirty( const shared_ptr<Element>& aElement ) {
+	if( !aElement ) return false;
+	auto it = mBatchesForElement.find( aElement.get() );
+	if( it == mBatchesForElement.end() ) {
+		return false;
+	}
+	for( auto batchIndex : it->second ) {
+		mBatches[batchIndex].bDirty = true;
+	}
+	mBAnyDirty = true;
+	return true;
+}
+
+//--------------------------------------------------------------
+void BatchRenderer::markAllDirty() {
+	for( auto& batch : mBatches ) {
+		batch.bDirty = true;
+	}
+	mBAnyDirty = mBatches.size() > 0;
+}
+
+//--------------------------------------------------------------
+std::size_t BatchRenderer::getNumDirtyBatches() {
+	std::size_t numDirty = 0;
+	for( auto& batch : mBatches ) {
+		if( batch.bDirty ) numDirty++;
+	}
+	return numDirty;
+}
+
+//--------------------------------------------------------------
+void BatchRenderer::update() {
+	if( !mBAnyDirty ) return;
+	mBAnyDirty = false;
+	for( auto& batch : mBatches ) {
+		if( batch.bDirty ) {
+			_rebuildBatch( batch );
+			// still waiting on images to decode
+			mBAnyDirty = mBAnyDirty || batch.bDirty;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void BatchRenderer::draw() {
+	update();
+
+	ofPushStyle();
+	for( auto& batch : mBatches ) {
+		if( batch.mode == BATCH_ELEMENT ) {
+			for( auto& item : batch.items ) {
+				bool bTrans = item.offset.x != 0.f || item.offset.y != 0.f;
+				if( bTrans ) {
+					ofPushMatrix();
+					ofTranslate( item.offset.x, item.offset.y );
+				}
+				item.element->draw();
+				if( bTrans ) {
+					ofPopMatrix();
+				}
+			}
+			continue;
+		}
+
+		if( batch.mesh.getNumVertices() < 1 ) continue;
+
+		if( batch.mode == BATCH_STROKE ) {
+			ofSetLineWidth( batch.lineWidth );
+			batch.mesh.draw();
+		} else if( batch.mode == BATCH_TEXTURE ) {
+			// all of the images in the batch share the texture
+			auto ttex = batch.items.size() ? static_cast<Image&>( *batch.items[0].element ).getTexture() : nullptr;
+			if( ttex && ttex->isAllocated() ) {
+				ttex->bind();
+				batch.mesh.draw();
+				ttex->unbind();
+			}
+		} else {
+			batch.mesh.draw();
+		}
+	}
+	ofPopStyle();
+}
+
+//--------------------------------------------------------------
+void BatchRenderer::_collectRecursive( Group& aGroup, const glm::vec2& aOffset ) {
+	const Group& cgroup = aGroup;
+	for( auto& kid : cgroup.getChildren() ) {
+		if( !kid ) continue;
+		auto etype = kid->getType();
+		if( etype == TYPE_GROUP ) {
+			auto& kgroup = static_cast<Group&>( *kid );
+			_collectRecursive( kgroup, aOffset + kgroup.pos );
+		} else if( etype == TYPE_TEXT ) {
+			_addItem( kid, aOffset, BATCH_ELEMENT, 1.f, nullptr );
+		} else if( etype == TYPE_IMAGE ) {
+			// images that share a file or an atlas page share a texture, so they can be merged.
+			// The pixels may still be decoding, the batch is rebuilt until they are ready.
+			auto& eimage = static_cast<Image&>( *kid );
+			if( eimage.isInAtlas() || !eimage.getCacheEntry()->isFailed() ) {
+				_addItem( kid, aOffset, BATCH_TEXTURE, 1.f, eimage.getTextureKey() );
+			}
+		} else if( etype == TYPE_PATH || etype == TYPE_RECTANGLE || etype == TYPE_CIRCLE || etype == TYPE_ELLIPSE ) {
+			// same order as ofPath::draw, fill first and then the stroke
+			auto& epath = static_cast<Path&>( *kid );
+			if( epath.isFilled() ) {
+				_addItem( kid, aOffset, BATCH_FILL, 1.f, nullptr );
+			}
+			if( epath.hasStroke() ) {
+				if( epath.isStrokeTessellationEnabled() ) {
+					// the stroke triangles can share the batch with the fills
+					_addItem( kid, aOffset, BATCH_FILL, 1.f, nullptr, true );
+				} else {
+					_addItem( kid, aOffset, BATCH_STROKE, epath.getStrokeWidth(), nullptr );
+				}
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void BatchRenderer::_addItem( const shared_ptr<Element>& aElement, const glm::vec2& aOffset, BatchMode aMode, float aLineWidth, const void* aTextureKey, bool abStrokeMesh ) {
+	ofRectangle tbounds;
+	if( !SpatialIndex::sComputeBounds( *aElement, aOffset, tbounds )) {
+		// nothing to draw
+		return;
+	}
+
+	bool bUseColors = aElement->bUseShapeColor;
+
+	// find a batch with the same state that this item can be merged into
+	// without being drawn on top of something that was added after that batch
+	int targetIndex = -1;
+	std::size_t numLookedAt = 0;
+	for( std::size_t i = mBatches.size(); i-- > 0 && numLookedAt < sMaxMergeLookback; numLookedAt++ ) {
+		auto& batch = mBatches[i];
+		if( _isSameState( batch, aMode, aLineWidth, aTextureKey, bUseColors )) {
+			targetIndex = (int)i;
+			break;
+		}
+		if( batch.bHasBounds && batch.bounds.intersects( tbounds )) {
+			break;
+		}
+	}
+
+	if( targetIndex < 0 ) {
+		mBatches.push_back( Batch() );
+		auto& batch = mBatches.back();
+		batch.mode = aMode;
+		batch.lineWidth = aLineWidth;
+		batch.textureKey = aTextureKey;
+		batch.bUseColors = bUseColors;
+		targetIndex = (int)mBatches.size() - 1;
+	}
+
+	auto& batch = mBatches[targetIndex];
+	if( batch.bHasBounds ) {
+		batch.bounds.growToInclude( tbounds );
+	} else {
+		batch.bounds = tbounds;
+		batch.bHasBounds = true;
+	}
+	Item item;
+	item.element = aElement;
+	item.offset = aOffset;
+	item.bStrokeMesh = abStrokeMesh;
+	batch.items.push_back( item );
+	batch.bDirty = true;
+
+	auto& elementBatches = mBatchesForElement[ aElement.get() ];
+	if( elementBatches.empty() || elementBatches.back() != (std::size_t)targetIndex ) {
+		elementBatches.push_back( (std::size_t)targetIndex );
+	}
+}
+
+//--------------------------------------------------------------
+bool BatchRenderer::_isSameState( const Batch& aBatch, BatchMode aMode, float aLineWidth, const void* aTextureKey, bool abUseColors ) const {
+	if( aBatch.mode != aMode || aBatch.bUseColors != abUseColors ) {
+		return false;
+	}
+	if( aMode == BATCH_STROKE ) {
+		return aBatch.lineWidth == aLineWidth;
+	}
+	if( aMode == BATCH_TEXTURE ) {
+		return aBatch.textureKey == aTextureKey;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+void BatchRenderer::_rebuildBatch( Batch& aBatch ) {
+	aBatch.mesh.clear();
+	aBatch.bDirty = false;
+	if( aBatch.mode == BATCH_ELEMENT ) {
+		return;
+	}
+
+	aBatch.mesh.setMode( aBatch.mode == BATCH_STROKE ? OF_PRIMITIVE_LINES : OF_PRIMITIVE_TRIANGLES );
+	for( auto& item : aBatch.items ) {
+		if( !item.element->isVisible() ) continue;
+		if( aBatch.mode == BATCH_FILL ) {
+			if( item.bStrokeMesh ) {
+				_addStrokeMesh( aBatch.mesh, static_cast<Path&>( *item.element ), item.offset, aBatch.bUseColors );
+			} else {
+				_addFill( aBatch.mesh, static_cast<Path&>( *item.element ), item.offset, aBatch.bUseColors );
+			}
+		} else if( aBatch.mode == BATCH_STROKE ) {
+			_addStroke( aBatch.mesh, static_cast<Path&>( *item.element ), item.offset, aBatch.bUseColors );
+		} else if( aBatch.mode == BATCH_TEXTURE ) {
+			if( !_addImage( aBatch.mesh, static_cast<Image&>( *item.element ), item.offset, aBatch.bUseColors )) {
+				aBatch.bDirty = true;
+			}
+		}
+	}
+
+	if( aBatch.bUseColors ) {
+		aBatch.mesh.enableColors();
+	} else {
+		// use the current color, like ofPath and ofImage do when the shape colors are disabled
+		aBatch.mesh.disableColors();
+	}
+}
+
+//--------------------------------------------------------------
+void BatchRenderer::_addFill( ofMesh& aMesh, Path& aPath, const glm::vec2& aOffset, bool abUseColors ) {
+	const ofMesh& tess = aPath.path.getTessellation();
+	const auto& tverts = tess.getVertices();
+	if( tverts.size() < 3 ) return;
+
+	ofIndexType baseIndex = (ofIndexType)aMesh.getVertices().size();
+	glm::vec3 offset( aOffset.x, aOffset.y, 0.f );
+	ofFloatColor fillColor = aPath.getFillColor();
+	for( auto& v : tverts ) {
+		aMesh.addVertex( v + offset );
+		if( abUseColors ) aMesh.addColor( fillColor );
+	}
+	const auto& tindices = tess.getIndices();
+	if( tindices.size() ) {
+		for( auto index : tindices ) {
+			aMesh.addIndex( baseIndex + index );
+		}
+	} else {
+		for( std::size_t i = 0; i < tverts.size(); i++ ) {
+			aMesh.addIndex( baseIndex + (ofIndexType)i );
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void BatchRenderer::_addStroke( ofMesh& aMesh, Path& aPath, const glm::vec2& aOffset, bool abUseColors ) {
+	glm::vec3 offset( aOffset.x, aOffset.y, 0.f );
+	ofFloatColor strokeColor = aPath.getStrokeColor();
+	for( auto& outline : aPath.path.getOutline() ) {
+		const auto& tverts = outline.getVertices();
+		if( tverts.size() < 2 ) continue;
+		ofIndexType baseIndex = (ofIndexType)aMesh.getVertices().size();
+		for( auto& v : tverts ) {
+			aMesh.addVertex( v + offset );
+			if( abUseColors ) aMesh.addColor( strokeColor );
+		}
+		ofIndexType numVerts = (ofIndexType)tverts.size();
+		for( ofIndexType i = 0; i + 1 < numVerts; i++ ) {
+			aMesh.addIndex( baseIndex + i );
+			aMesh.addIndex( baseIndex + i + 1 );
+		}
+		if( outline.isClosed() ) {
+			aMesh.addIndex( baseIndex + numVerts - 1 );
+			aMesh.addIndex( baseIndex );
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void BatchRenderer::_addStrokeMesh( ofMesh& aMesh, Path& aPath, const glm::vec2& aOffset, bool abUseColors ) {
+	const ofMesh& tstroke = aPath.getStrokeMesh();
+	if( tstroke.getNumIndices() < 3 ) return;
+
+	ofIndexType baseIndex = (ofIndexType)aMesh.getVertices().size();
+	glm::vec3 offset( aOffset.x, aOffset.y, 0.f );
+	ofFloatColor strokeColor = aPath.getStrokeColor();
+	for( auto& v : tstroke.getVertices() ) {
+		aMesh.addVertex( v + offset );
+		if( abUseColors ) aMesh.addColor( strokeColor );
+	}
+	for( auto index : tstroke.getIndices() ) {
+		aMesh.addIndex( baseIndex + index );
+	}
+}
+
+//--------------------------------------------------------------
+bool BatchRenderer::_addImage( ofMesh& aMesh, Image& aImage, const glm::vec2& aOffset, bool abUseColors ) {
+	auto ttex = aImage.getTexture();
+	if( !ttex ) {
+		// still decoding, or failed
+		return aImage.getCacheEntry()->isFailed();
+	}
+	auto& tex = *ttex;
+	ofRectangle trect = aImage.getTextureRect();
+	float w = trect.width;
+	float h = trect.height;
+
+	// same transform as Image::draw
+	auto transform = aImage.getTransformMatrix();
+	glm::vec3 offset( aOffset.x, aOffset.y, 0.f );
+	ofFloatColor color = aImage.getColor();
+
+	ofIndexType baseIndex = (ofIndexType)aMesh.getVertices().size();
+	const glm::vec2 corners[4] = { glm::vec2(0.f, 0.f), glm::vec2(w, 0.f), glm::vec2(w, h), glm::vec2(0.f, h) };
+	for( auto& corner : corners ) {
+		aMesh.addVertex( glm::vec3( transform * glm::vec4( corner.x, corner.y, 0.f, 1.f )) + offset );
+		aMesh.addTexCoord( tex.getCoordFromPoint( trect.x + corner.x, trect.y + corner.y ));
+		if( abUseColors ) aMesh.addColor( color );
+	}
+	aMesh.addIndex( baseIndex + 0 );
+	aMesh.addIndex( baseIndex + 1 );
+	aMesh.addIndex( baseIndex + 2 );
+	aMesh.addIndex( baseIndex + 0 );
+	aMesh.addIndex( baseIndex + 2 );
+	aMesh.addIndex( baseIndex + 3 );
+	return true;
+}
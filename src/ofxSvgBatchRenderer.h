@@ -0,0 +1,91 @@
+//
+//  ofxSvgBatchRenderer.h
+//
+//  Retained mode renderer that merges the fills, strokes and images of the document into
+//  a small number of vbo meshes. Elements keep their colors in the vertex colors and are
+//  only merged with earlier batches when nothing drawn in between overlaps them, so the
+//  draw order of the document is kept.
+//
+
+#pragma once
+#include "ofxSvgElements.h"
+#include "ofVboMesh.h"
+#include <unordered_map>
+
+namespace ofx::svg {
+class Group;
+
+class BatchRenderer {
+public:
+	// tessellates all of the elements below aRoot, call again after adding or removing elements
+	// or when the fill, stroke or texture of an element changes.
+	void build( Group& aRoot );
+	void clear();
+
+	// rebuilds the batches that contain the element on the next draw.
+	// Use after changing the colors or visibility of an element, or its shape in place.
+	// Moving an element over others can change the draw order, call build() instead.
+	// returns false if the element is not in any batch.
+	bool markDirty( const std::shared_ptr<Element>& aElement );
+	void markAllDirty();
+	// rebuilds the dirty batches, called from draw
+	void update();
+	void draw();
+
+	bool isEmpty() { return mBatches.empty(); }
+	std::size_t getNumBatches() { return mBatches.size(); }
+	std::size_t getNumDirtyBatches();
+	std::size_t getNumElements() { return mBatchesForElement.size(); }
+
+protected:
+	enum BatchMode {
+		BATCH_FILL = 0,
+		BATCH_STROKE,
+		BATCH_TEXTURE,
+		// elements that can not be merged yet ( text ), drawn one by one
+		BATCH_ELEMENT
+	};
+
+	struct Item {
+		std::shared_ptr<Element> element;
+		// accumulated positions of the parent groups
+		glm::vec2 offset;
+		// the tessellated stroke of a path, drawn in a fill batch
+		bool bStrokeMesh = false;
+	};
+
+	struct Batch {
+		BatchMode mode = BATCH_FILL;
+		float lineWidth = 1.f;
+		// the images in a texture batch share a texture, see Image::getTextureKey
+		const void* textureKey = nullptr;
+		// false when the elements do not use their shape colors, so the current color is applied
+		bool bUseColors = true;
+
+		// bounds of all of the items, used when deciding if later items can be merged
+		ofRectangle bounds;
+		bool bHasBounds = false;
+
+		std::vector<Item> items;
+		ofVboMesh mesh;
+		bool bDirty = true;
+	};
+
+	void _collectRecursive( Group& aGroup, const glm::vec2& aOffset );
+	void _addItem( const std::shared_ptr<Element>& aElement, const glm::vec2& aOffset, BatchMode aMode, float aLineWidth, const void* aTextureKey, bool abStrokeMesh = false );
+	bool _isSameState( const Batch& aBatch, BatchMode aMode, float aLineWidth, const void* aTextureKey, bool abUseColors ) const;
+	void _rebuildBatch( Batch& aBatch );
+	void _addFill( ofMesh& aMesh, Path& aPath, const glm::vec2& aOffset, bool abUseColors );
+	void _addStroke( ofMesh& aMesh, Path& aPath, const glm::vec2& aOffset, bool abUseColors );
+	void _addStrokeMesh( ofMesh& aMesh, Path& aPath, const glm::vec2& aOffset, bool abUseColors );
+	// returns false if the image is still decoding
+	bool _addImage( ofMesh& aMesh, Image& aImage, const glm::vec2& aOffset, bool abUseColors );
+
+	// how many batches back to look for one with the same state before starting a new batch
+	static const std::size_t sMaxMergeLookback = 8;
+
+	std::vector<Batch> mBatches;
+	std::unordered_map< Element*, std::vector<std::size_t> > mBatchesForElement;
+	bool mBAnyDirty = false;
+};
+}
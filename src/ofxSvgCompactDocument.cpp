@@ -0,0 +1,219 @@
+//
+//  ofxSvgCompactDocument.cpp
+//
+
+#include "ofxSvgCompactDocument.h"
+#include "ofxSvgGroup.h"
+#include "ofxSvgSpatialIndex.h"
+#include "ofGraphics.h"
+
+using namespace ofx::svg;
+using std::vector;
+using std::shared_ptr;
+
+//--------------------------------------------------------------
+void CompactDocument::build( Group& aRoot ) {
+	clear();
+	mRootOffset = aRoot.pos;
+	_addRecursive( aRoot, -1 );
+
+	std::size_t numElements = mElements.size();
+	mOffsets.assign( numElements, glm::vec2( 0.f, 0.f ));
+	mVisibleInTree.assign( numElements, 0 );
+	mLocalBounds.assign( numElements, ofRectangle() );
+	mHasLocalBounds.assign( numElements, 0 );
+	mBounds.assign( numElements, ofRectangle() );
+	mHasBounds.assign( numElements, 0 );
+	syncFromElements();
+}
+
+//--------------------------------------------------------------
+void CompactDocument::clear() {
+	mElements.clear();
+	mIds.clear();
+	mTypes.clear();
+	mParents.clear();
+	mSubtreeEnds.clear();
+	mPositions.clear();
+	mScales.clear();
+	mRotations.clear();
+	mLayers.clear();
+	mVisible.clear();
+	mOffsets.clear();
+	mVisibleInTree.clear();
+	mLocalBounds.clear();
+	mHasLocalBounds.clear();
+	mBounds.clear();
+	mHasBounds.clear();
+	mNumDrawnElements = 0;
+	mNumCulledElements = 0;
+}
+
+//--------------------------------------------------------------
+int CompactDocument::getId( const Element* aElement ) const {
+	auto it = mIds.find( aElement );
+	if( it == mIds.end() ) {
+		return -1;
+	}
+	return (int)it->second;
+}
+
+//--------------------------------------------------------------
+void CompactDocument::update() {
+	std::size_t numElements = mElements.size();
+	// parents always come before their children
+	for( std::size_t i = 0; i < numElements; i++ ) {
+		int parent = mParents[i];
+		if( parent < 0 ) {
+			mOffsets[i] = mRootOffset;
+			mVisibleInTree[i] = mVisible[i];
+		} else {
+			mOffsets[i] = mOffsets[parent] + mPositions[parent];
+			mVisibleInTree[i] = mVisible[i] && mVisibleInTree[parent];
+		}
+		mHasBounds[i] = 0;
+	}
+
+	// children always come after their parents, so walking backwards finishes a group before it is added to its parent
+	for( std::size_t i = numElements; i-- > 0; ) {
+		if( mTypes[i] != TYPE_GROUP && mHasLocalBounds[i] ) {
+			mBounds[i] = mLocalBounds[i];
+			mBounds[i].x += mOffsets[i].x;
+			mBounds[i].y += mOffsets[i].y;
+			mHasBounds[i] = 1;
+		}
+		int parent = mParents[i];
+		if( parent < 0 || !mHasBounds[i] ) continue;
+		if( mHasBounds[parent] ) {
+			mBounds[parent].growToInclude( mBounds[i] );
+		} else {
+			mBounds[parent] = mBounds[i];
+			mHasBounds[parent] = 1;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void CompactDocument::applyToElements() {
+	for( std::size_t i = 0; i < mElements.size(); i++ ) {
+		auto& ele = *mElements[i];
+		ele.pos = mPositions[i];
+		ele.scale = mScales[i];
+		ele.rotation = mRotations[i];
+		ele.layer = mLayers[i];
+		ele.setVisible( mVisible[i] != 0 );
+	}
+}
+
+//--------------------------------------------------------------
+void CompactDocument::syncFromElements() {
+	for( std::size_t i = 0; i < mElements.size(); i++ ) {
+		_readElement( i );
+	}
+	update();
+}
+
+//--------------------------------------------------------------
+void CompactDocument::queryRect( const ofRectangle& aRect, vector<uint32_t>& aIds, bool abVisibleOnly ) {
+	_query( [&aRect]( const ofRectangle& abounds ) { return aRect.intersects( abounds ); }, aIds, abVisibleOnly );
+}
+
+//--------------------------------------------------------------
+void CompactDocument::queryPoint( const glm::vec2& aPoint, vector<uint32_t>& aIds, bool abVisibleOnly ) {
+	_query( [&aPoint]( const ofRectangle& abounds ) { return abounds.inside( aPoint ); }, aIds, abVisibleOnly );
+}
+
+//--------------------------------------------------------------
+template<typename Test>
+void CompactDocument::_query( Test&& aTest, vector<uint32_t>& aIds, bool abVisibleOnly ) {
+	std::size_t numElements = mElements.size();
+	std::size_t i = 0;
+	while( i < numElements ) {
+		if( !mHasBounds[i] || ( abVisibleOnly && !mVisibleInTree[i] ) || !aTest( mBounds[i] )) {
+			i = mSubtreeEnds[i];
+			continue;
+		}
+		if( mTypes[i] != TYPE_GROUP ) {
+			aIds.push_back( (uint32_t)i );
+		}
+		i++;
+	}
+}
+
+//--------------------------------------------------------------
+void CompactDocument::draw( const ofRectangle& aViewRect ) {
+	mNumDrawnElements = 0;
+	mNumCulledElements = 0;
+
+	// only translate again when the offset changes, siblings share it
+	bool bPushed = false;
+	glm::vec2 currentOffset( 0.f, 0.f );
+
+	std::size_t numElements = mElements.size();
+	std::size_t i = 0;
+	while( i < numElements ) {
+		bool bGroup = mTypes[i] == TYPE_GROUP;
+		if( !mVisibleInTree[i] || !mHasBounds[i] || !aViewRect.intersects( mBounds[i] )) {
+			std::size_t tend = mSubtreeEnds[i];
+			for( std::size_t k = i; k < tend; k++ ) {
+				if( mTypes[k] != TYPE_GROUP ) mNumCulledElements++;
+			}
+			i = tend;
+			continue;
+		}
+		if( !bGroup ) {
+			const auto& toffset = mOffsets[i];
+			if( !bPushed || toffset != currentOffset ) {
+				if( bPushed ) ofPopMatrix();
+				ofPushMatrix();
+				ofTranslate( toffset.x, toffset.y );
+				currentOffset = toffset;
+				bPushed = true;
+			}
+			mElements[i]->draw();
+			mNumDrawnElements++;
+		}
+		i++;
+	}
+	if( bPushed ) {
+		ofPopMatrix();
+	}
+}
+
+//--------------------------------------------------------------
+void CompactDocument::_addRecursive( Group& aGroup, int aParent ) {
+	const Group& cgroup = aGroup;
+	for( auto& kid : cgroup.getChildren() ) {
+		if( !kid ) continue;
+		uint32_t tid = (uint32_t)mElements.size();
+		mElements.push_back( kid );
+		mIds[ kid.get() ] = tid;
+		mTypes.push_back( (uint8_t)kid->getType() );
+		mParents.push_back( aParent );
+		mSubtreeEnds.push_back( tid + 1 );
+		mPositions.push_back( kid->pos );
+		mScales.push_back( kid->scale );
+		mRotations.push_back( kid->rotation );
+		mLayers.push_back( kid->layer );
+		mVisible.push_back( kid->isVisible() ? 1 : 0 );
+		if( kid->isGroup() ) {
+			_addRecursive( static_cast<Group&>( *kid ), (int)tid );
+			mSubtreeEnds[tid] = (uint32_t)mElements.size();
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void CompactDocument::_readElement( std::size_t aId ) {
+	auto& ele = *mElements[aId];
+	mPositions[aId] = ele.pos;
+	mScales[aId] = ele.scale;
+	mRotations[aId] = ele.rotation;
+	mLayers[aId] = ele.layer;
+	mVisible[aId] = ele.isVisible() ? 1 : 0;
+	if( mTypes[aId] != TYPE_GROUP ) {
+		ofRectangle tbounds;
+		mHasLocalBounds[aId] = SpatialIndex::sComputeBounds( ele, glm::vec2( 0.f, 0.f ), tbounds ) ? 1 : 0;
+		mLocalBounds[aId] = tbounds;
+	}
+}
@@ -0,0 +1,107 @@
+//
+//  ofxSvgCompactDocument.h
+//
+//  Flattened copy of a document that keeps the fields used by transform, culling and query
+//  passes in parallel arrays indexed by element id. The ids are in depth first order, so the
+//  descendants of a group are the ids between it and the end of its subtree and the passes
+//  are linear scans instead of pointer chasing through the hierarchy.
+//
+
+#pragma once
+#include "ofxSvgElements.h"
+#include <unordered_map>
+
+namespace ofx::svg {
+class Group;
+
+class CompactDocument {
+public:
+	// flattens the hierarchy below aRoot, the root is not included.
+	// Call again after adding or removing elements.
+	void build( Group& aRoot );
+	void clear();
+
+	std::size_t size() const { return mElements.size(); }
+	bool empty() const { return mElements.empty(); }
+
+	// -1 if the element is not below the root
+	int getId( const Element* aElement ) const;
+	// the elements stay the owners of their geometry, styles and meshes
+	Element* getElement( std::size_t aId ) const { return mElements[aId].get(); }
+	const std::shared_ptr<Element>& getShared( std::size_t aId ) const { return mElements[aId]; }
+
+	// the arrays can be changed directly, call update() afterwards and applyToElements() to copy them back
+	std::vector<glm::vec2>& getPositions() { return mPositions; }
+	std::vector<glm::vec2>& getScales() { return mScales; }
+	std::vector<float>& getRotations() { return mRotations; }
+	std::vector<float>& getLayers() { return mLayers; }
+	std::vector<uint8_t>& getVisible() { return mVisible; }
+
+	const std::vector<uint8_t>& getTypes() const { return mTypes; }
+	// -1 for the children of the root
+	const std::vector<int>& getParents() const { return mParents; }
+	// one past the id of the last descendant, the id + 1 for elements that are not groups
+	const std::vector<uint32_t>& getSubtreeEnds() const { return mSubtreeEnds; }
+	// accumulated positions of the parent groups, the translation that Group::draw applies
+	const std::vector<glm::vec2>& getOffsets() const { return mOffsets; }
+	// visible along with all of the parent groups
+	const std::vector<uint8_t>& getVisibleInTree() const { return mVisibleInTree; }
+	// document space bounds, groups cover the bounds of their children
+	const std::vector<ofRectangle>& getBounds() const { return mBounds; }
+	const std::vector<uint8_t>& getHasBounds() const { return mHasBounds; }
+
+	// recomputes the offsets, visibility and bounds after changing the arrays, in one pass down and one pass up.
+	// The bounds of an element follow the positions of its parent groups, not its own position.
+	void update();
+	// copies the positions, scales, rotations, layers and visibility into the elements
+	void applyToElements();
+	// reads the fields and the bounds from the elements again, after changing them through the elements
+	void syncFromElements();
+
+	// ids of the non group elements whose bounds intersect the rectangle or contain the point,
+	// skipping whole groups that do not
+	void queryRect( const ofRectangle& aRect, std::vector<uint32_t>& aIds, bool abVisibleOnly = true );
+	void queryPoint( const glm::vec2& aPoint, std::vector<uint32_t>& aIds, bool abVisibleOnly = true );
+
+	// draws the visible elements that intersect the view rectangle in document order
+	void draw( const ofRectangle& aViewRect );
+	std::size_t getNumDrawnElements() { return mNumDrawnElements; }
+	std::size_t getNumCulledElements() { return mNumCulledElements; }
+
+	// will log messages to this module name
+	static const std::string moduleName() { return "ofx::svg::CompactDocument"; }
+
+protected:
+	void _addRecursive( Group& aGroup, int aParent );
+	void _readElement( std::size_t aId );
+	template<typename Test>
+	void _query( Test&& aTest, std::vector<uint32_t>& aIds, bool abVisibleOnly );
+
+	glm::vec2 mRootOffset = glm::vec2( 0.f, 0.f );
+
+	std::vector< std::shared_ptr<Element> > mElements;
+	std::unordered_map< const Element*, uint32_t > mIds;
+
+	// hot fields
+	std::vector<uint8_t> mTypes;
+	std::vector<int> mParents;
+	std::vector<uint32_t> mSubtreeEnds;
+	std::vector<glm::vec2> mPositions;
+	std::vector<glm::vec2> mScales;
+	std::vector<float> mRotations;
+	std::vector<float> mLayers;
+	std::vector<uint8_t> mVisible;
+
+	// derived by update
+	std::vector<glm::vec2> mOffsets;
+	std::vector<uint8_t> mVisibleInTree;
+	// bounds of the geometry without the offsets of the parent groups
+	std::vector<ofRectangle> mLocalBounds;
+	std::vector<uint8_t> mHasLocalBounds;
+	std::vector<ofRectangle> mBounds;
+	std::vector<uint8_t> mHasBounds;
+
+	std::size_t mNumDrawnElements = 0;
+	std::size_t mNumCulledElements = 0;
+};
+}
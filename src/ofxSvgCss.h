@@ -7,6 +7,7 @@
 
 #pragma once
 #include <unordered_map>
+#include <cstdint>
 #include "ofColor.h"
 #include "ofLog.h"
 
@@ -75,6 +76,8 @@ public:
 	
 	std::unordered_map<std::string, Property> properties;
 	std::string name = "default";
+	// id of the name in the string table of the document, see Parser::getStringTable
+	uint32_t nameId = 0;
 	
 	static bool sIsNone( const std::string& astr );
 	static ofColor sGetColor(const std::string& astr);
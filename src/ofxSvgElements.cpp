@@ -5,6 +5,11 @@
 //
 
 #include "ofxSvgElements.h"
+#include "ofxSvgFontIndex.h"
+#include "ofxSvgFontMetrics.h"
+#include "ofxSvgMemoryStats.h"
+#include "ofxSvgGroup.h"
+#include "ofxSvgSpatialIndex.h"
 #include "ofGraphics.h"
 
 using std::vector;
@@ -12,6 +17,7 @@ using std::string;
 using namespace ofx::svg;
 
 std::map< string, Text::Font > Text::fonts;
+std::map< string, std::shared_ptr<SdfFontAtlas> > Text::sdfFonts;
 ofTrueTypeFont Text::defaultFont;
 
 //--------------------------------------------------------------
@@ -108,6 +114,343 @@ ofNode Element::getNodeTransform() {
     return tnode;
 }
 
+#pragma mark - Path
+//--------------------------------------------------------------
+ofRectangle Element::getLocalBounds() {
+	if( isGroup() ) {
+		// picks up children changed through Group::getChildren()
+		static_cast<Group*>( this )->_syncChildren();
+	}
+	if( mBLocalBoundsDirty ) {
+		_updateLocalBounds();
+	}
+	return mLocalBounds;
+}
+
+//--------------------------------------------------------------
+ofRectangle Element::getGlobalBounds() {
+	ofRectangle tbounds = getLocalBounds();
+	// Group::draw translates by the position of each group
+	Group* parent = mParent;
+	while( parent ) {
+		tbounds.x += parent->pos.x;
+		tbounds.y += parent->pos.y;
+		parent = parent->mParent;
+	}
+	return tbounds;
+}
+
+//--------------------------------------------------------------
+bool Element::hasBounds() {
+	if( isGroup() ) {
+		static_cast<Group*>( this )->_syncChildren();
+	}
+	if( mBLocalBoundsDirty ) {
+		_updateLocalBounds();
+	}
+	return mBHasLocalBounds;
+}
+
+//--------------------------------------------------------------
+void Element::invalidateBounds() {
+	mBLocalBoundsDirty = true;
+	Group* parent = mParent;
+	while( parent ) {
+		parent->mBLocalBoundsDirty = true;
+		parent->mBBoundsDirty = true;
+		parent = parent->mParent;
+	}
+}
+
+//--------------------------------------------------------------
+bool Element::_computeLocalBounds( ofRectangle& aBounds ) {
+	return SpatialIndex::sComputeBounds( *this, glm::vec2( 0.f, 0.f ), aBounds );
+}
+
+//--------------------------------------------------------------
+void Element::_updateLocalBounds() {
+	mLocalBounds = ofRectangle();
+	mBHasLocalBounds = _computeLocalBounds( mLocalBounds );
+	if( !mBHasLocalBounds ) {
+		mLocalBounds = ofRectangle();
+	}
+	mBLocalBoundsDirty = false;
+}
+
+//--------------------------------------------------------------
+void Element::addMemoryUsage( MemoryUsage& aUsage ) {
+	aUsage.strings += MemoryUsage::sGetNumBytes( name );
+}
+
+//--------------------------------------------------------------
+void Path::draw() {
+	if( !isVisible() ) return;
+	ofPath* tpath = &path;
+	if( mBLodEnabled ) {
+		if( mLods.empty() && !mLodJob ) {
+			buildLods( true );
+		}
+		if( mLodJob && mLodJob->isDone() ) {
+			_setLods( mLodJob->getOutlines() );
+			mLodJob.reset();
+		}
+		// the full path is drawn until the levels are ready
+		if( mLods.size() ) {
+			updateLod( sGetCurrentPixelScale() );
+			if( mCurrentLod > 0 ) {
+				tpath = &mLods[ mCurrentLod - 1 ].path;
+			}
+		}
+	}
+	if( !mBTessellateStroke || !hasStroke() ) {
+		tpath->draw();
+		return;
+	}
+	
+	// same as ofPath::draw, with the stroke from the triangles
+	if( bUseShapeColor ) ofPushStyle();
+	if( tpath->isFilled() ) {
+		if( bUseShapeColor ) ofSetColor( tpath->getFillColor() );
+		tpath->getTessellation().draw();
+	}
+	if( bUseShapeColor ) ofSetColor( path.getStrokeColor() );
+	getStrokeMesh().draw();
+	if( bUseShapeColor ) ofPopStyle();
+}
+
+//--------------------------------------------------------------
+ofVboMesh& Path::getStrokeMesh() {
+	float twidth = hasStroke() ? getStrokeWidth() : 0.f;
+	if( mBStrokeMeshDirty || twidth != mStrokeMeshWidth || mStrokeStyle != mStrokeMeshStyle ) {
+		mStrokeMesh.clear();
+		mStrokeMesh.setMode( OF_PRIMITIVE_TRIANGLES );
+		StrokeTessellator::sTessellate( path.getOutline(), twidth, mStrokeStyle, mStrokeMesh );
+		mStrokeMeshWidth = twidth;
+		mStrokeMeshStyle = mStrokeStyle;
+		mBStrokeMeshDirty = false;
+	}
+	return mStrokeMesh;
+}
+
+//--------------------------------------------------------------
+void Path::setLodEnabled( bool ab, int aNumLevels, float aBaseTolerance ) {
+	aNumLevels = std::max( 1, aNumLevels );
+	aBaseTolerance = std::max( 0.0001f, aBaseTolerance );
+	if( aNumLevels != mNumLodLevels || aBaseTolerance != mLodBaseTolerance || !ab ) {
+		clearLods();
+	}
+	mBLodEnabled = ab;
+	mNumLodLevels = aNumLevels;
+	mLodBaseTolerance = aBaseTolerance;
+}
+
+//--------------------------------------------------------------
+void Path::buildLods( bool abAsync ) {
+	// the outlines are copied, so the worker does not touch the path
+	if( abAsync ) {
+		mLodJob = LodBuilder::sGetShared().request( [ toutlines = path.getOutline(), tnumLevels = mNumLodLevels, ttolerance = mLodBaseTolerance ]() {
+			return _sSimplifyOutlines( toutlines, tnumLevels, ttolerance );
+		});
+	} else {
+		mLodJob.reset();
+		_setLods( _sSimplifyOutlines( path.getOutline(), mNumLodLevels, mLodBaseTolerance ));
+	}
+}
+
+//--------------------------------------------------------------
+void Path::clearLods() {
+	mLods.clear();
+	// does not wait for a job that is still building
+	mLodJob.reset();
+	mCurrentLod = 0;
+}
+
+//--------------------------------------------------------------
+std::size_t Path::getNumVerticesForLod( int aLevel ) {
+	if( aLevel > 0 && aLevel <= (int)mLods.size() ) {
+		return mLods[ aLevel - 1 ].numVertices;
+	}
+	std::size_t tnum = 0;
+	for( auto& tline : path.getOutline() ) {
+		tnum += tline.size();
+	}
+	return tnum;
+}
+
+//--------------------------------------------------------------
+void Path::updateLod( float aPixelScale ) {
+	if( mLods.empty() || aPixelScale <= 0.f ) {
+		mCurrentLod = 0;
+		return;
+	}
+	// the simplification is not visible while it is below half a pixel
+	float tallowed = 0.5f / aPixelScale;
+	auto tlevelFor = [this]( float aTolerance ) {
+		int tlevel = 0;
+		while( tlevel < (int)mLods.size() && mLods[ tlevel ].tolerance <= aTolerance ) {
+			tlevel++;
+		}
+		return tlevel;
+	};
+	int tcoarser = tlevelFor( tallowed / ( 1.f + mLodHysteresis ));
+	int tfiner = tlevelFor( tallowed * ( 1.f + mLodHysteresis ));
+	mCurrentLod = std::max( tcoarser, std::min( mCurrentLod, tfiner ));
+}
+
+//--------------------------------------------------------------
+float Path::sGetCurrentPixelScale() {
+	glm::mat4 mvp = ofGetCurrentMatrix( OF_MATRIX_PROJECTION ) * ofGetCurrentMatrix( OF_MATRIX_MODELVIEW );
+	ofRectangle tviewport = ofGetCurrentViewport();
+	auto toPixels = [&]( const glm::vec4& p ) {
+		glm::vec4 tclip = mvp * p;
+		if( fabs( tclip.w ) < 0.000001f ) tclip.w = 0.000001f;
+		return glm::vec2( tclip.x / tclip.w * tviewport.width * 0.5f, tclip.y / tclip.w * tviewport.height * 0.5f );
+	};
+	glm::vec2 torigin = toPixels( glm::vec4( 0.f, 0.f, 0.f, 1.f ));
+	float sx = glm::length( toPixels( glm::vec4( 1.f, 0.f, 0.f, 1.f )) - torigin );
+	float sy = glm::length( toPixels( glm::vec4( 0.f, 1.f, 0.f, 1.f )) - torigin );
+	return ( sx + sy ) * 0.5f;
+}
+
+//--------------------------------------------------------------
+Path::LodOutlines Path::_sSimplifyOutlines( vector<ofPolyline> aOutlines, int aNumLevels, float aBaseTolerance ) {
+	LodOutlines tlevels;
+	float ttolerance = aBaseTolerance;
+	for( int i = 0; i < aNumLevels; i++ ) {
+		// each level simplifies the previous one further
+		for( auto& tline : aOutlines ) {
+			tline.simplify( ttolerance );
+		}
+		tlevels.push_back( aOutlines );
+		ttolerance *= 4.f;
+	}
+	return tlevels;
+}
+
+//--------------------------------------------------------------
+void Path::simplify( float aTolerance ) {
+	vector<ofPolyline> toutlines = path.getOutline();
+	// the path keeps its style, only the commands are replaced
+	path.clear();
+	for( auto& tline : toutlines ) {
+		// the passes share the tolerance, so the outline stays within it
+		_sMergeCollinear( tline, aTolerance * 0.5f );
+		tline.simplify( aTolerance * 0.5f );
+		const auto& tverts = tline.getVertices();
+		if( tverts.size() < 2 ) continue;
+		path.moveTo( tverts[0] );
+		for( std::size_t k = 1; k < tverts.size(); k++ ) {
+			path.lineTo( tverts[k] );
+		}
+		if( tline.isClosed() ) {
+			path.close();
+		}
+	}
+	clearLods();
+	clearStrokeMesh();
+	invalidateBounds();
+}
+
+//--------------------------------------------------------------
+void Path::_sMergeCollinear( ofPolyline& aLine, float aTolerance ) {
+	auto& tverts = aLine.getVertices();
+	if( tverts.size() < 3 ) return;
+	
+	// sleeve fitting, each point narrows the range of directions from the anchor that pass within the
+	// tolerance of it, so the run can end at any point whose direction is still in the range.
+	// The vertices are compacted in place, the run ends at tnumKept - 1 when bRunHasEnd is set.
+	std::size_t tnumKept = 1;
+	glm::vec2 tanchor( tverts[0] );
+	bool bRunHasEnd = false;
+	bool bHasRef = false;
+	float tref = 0.f;
+	float tmin = -PI;
+	float tmax = PI;
+	float tmaxDistance = 0.f;
+	
+	for( std::size_t i = 1; i < tverts.size(); i++ ) {
+		glm::vec2 tdelta = glm::vec2( tverts[i] ) - tanchor;
+		float tdistance = glm::length( tdelta );
+		// going back towards the anchor is a corner
+		bool bOnRun = tdistance + aTolerance >= tmaxDistance;
+		if( bOnRun && tdistance > aTolerance ) {
+			float tangle = atan2f( tdelta.y, tdelta.x );
+			if( !bHasRef ) {
+				tref = tangle;
+				bHasRef = true;
+			}
+			float trel = ofWrap( tangle - tref, -PI, PI );
+			float thalf = asinf( aTolerance / tdistance );
+			if( trel < tmin || trel > tmax ) {
+				bOnRun = false;
+			} else {
+				tmin = std::max( tmin, trel - thalf );
+				tmax = std::min( tmax, trel + thalf );
+			}
+		}
+		
+		if( !bOnRun ) {
+			// the end of the run is kept and starts the next one
+			tanchor = glm::vec2( tverts[ tnumKept - 1 ] );
+			bRunHasEnd = false;
+			bHasRef = false;
+			tmin = -PI;
+			tmax = PI;
+			tdelta = glm::vec2( tverts[i] ) - tanchor;
+			tdistance = glm::length( tdelta );
+			if( tdistance > aTolerance ) {
+				tref = atan2f( tdelta.y, tdelta.x );
+				bHasRef = true;
+				float thalf = asinf( aTolerance / tdistance );
+				tmin = -thalf;
+				tmax = thalf;
+			}
+			tmaxDistance = 0.f;
+		}
+		
+		tmaxDistance = std::max( tmaxDistance, tdistance );
+		if( bRunHasEnd ) {
+			tverts[ tnumKept - 1 ] = tverts[i];
+		} else {
+			tverts[ tnumKept++ ] = tverts[i];
+			bRunHasEnd = true;
+		}
+	}
+	tverts.resize( tnumKept );
+}
+
+//--------------------------------------------------------------
+void Path::_setLods( const LodOutlines& aOutlines ) {
+	mLods.clear();
+	mCurrentLod = 0;
+	float ttolerance = mLodBaseTolerance;
+	for( auto& tlevel : aOutlines ) {
+		Lod tlod;
+		tlod.tolerance = ttolerance;
+		ttolerance *= 4.f;
+		for( auto& tline : tlevel ) {
+			const auto& tverts = tline.getVertices();
+			if( tverts.size() < 2 ) continue;
+			tlod.path.moveTo( tverts[0] );
+			for( std::size_t k = 1; k < tverts.size(); k++ ) {
+				tlod.path.lineTo( tverts[k] );
+			}
+			if( tline.isClosed() ) {
+				tlod.path.close();
+			}
+			tlod.numVertices += tverts.size();
+		}
+		// same style as the full path
+		tlod.path.setFilled( path.isFilled() );
+		tlod.path.setFillColor( path.getFillColor() );
+		tlod.path.setStrokeColor( path.getStrokeColor() );
+		tlod.path.setStrokeWidth( path.getStrokeWidth() );
+		tlod.path.setPolyWindingMode( path.getWindingMode() );
+		tlod.path.setUseShapeColor( path.getUseShapeColor() );
+		mLods.push_back( tlod );
+	}
+}
+
 #pragma mark - Image
 //--------------------------------------------------------------
 ofRectangle Image::getRectangle() {
@@ -115,20 +458,87 @@ ofRectangle Image::getRectangle() {
 }
 
 //--------------------------------------------------------------
-void Image::draw() {
+bool Image::load() {
+	auto tentry = getCacheEntry( false );
+	tentry->wait();
 	if( !bTryLoad ) {
-		img.load( getFilePath() );
 		bTryLoad = true;
+		if( !tentry->isFailed() ) {
+			img.setFromPixels( tentry->getPixels() );
+		}
 	}
-	
+	auto ttex = tentry->getTexture();
+	return ttex && ttex->isAllocated();
+}
+
+//--------------------------------------------------------------
+bool Image::isLoaded() {
+	return cacheEntry && cacheEntry->isDecoded();
+}
+
+//--------------------------------------------------------------
+std::shared_ptr<ImageCache::Entry> Image::getCacheEntry( bool abAsync ) {
+	if( !cacheEntry ) {
+		cacheEntry = ImageCache::sGetShared().request( filepath, abAsync );
+	}
+	return cacheEntry;
+}
+
+//--------------------------------------------------------------
+ofTexture* Image::getTexture() {
+	if( atlasPage ) {
+		return atlasPage->getTexture();
+	}
+	return getCacheEntry()->getTexture();
+}
+
+//--------------------------------------------------------------
+ofRectangle Image::getTextureRect() {
+	if( atlasPage ) {
+		return atlasRect;
+	}
+	auto tentry = getCacheEntry();
+	if( tentry->isDecoded() ) {
+		return ofRectangle( 0, 0, tentry->getPixels().getWidth(), tentry->getPixels().getHeight() );
+	}
+	return ofRectangle();
+}
+
+//--------------------------------------------------------------
+const void* Image::getTextureKey() {
+	if( atlasPage ) {
+		return atlasPage.get();
+	}
+	return getCacheEntry().get();
+}
+
+//--------------------------------------------------------------
+void Path::addMemoryUsage( MemoryUsage& aUsage ) {
+	Element::addMemoryUsage( aUsage );
+	aUsage.pathGeometry += MemoryUsage::sGetNumBytes( path );
+	aUsage.pathGeometry += mLods.capacity() * sizeof(Lod);
+	for( auto& tlod : mLods ) {
+		aUsage.pathGeometry += MemoryUsage::sGetNumBytes( tlod.path );
+	}
+	aUsage.pathGeometry += MemoryUsage::sGetNumBytes( mStrokeMesh );
+}
+
+//--------------------------------------------------------------
+void Image::draw() {
 	if( isVisible() ) {
-		if( img.isAllocated() ) {
+		// does not stall the frame, the image is drawn once it has been decoded
+		auto ttex = getTexture();
+		if( ttex && ttex->isAllocated() ) {
 			ofPushMatrix(); {
 				ofTranslate( pos.x, pos.y );
 				if( rotation != 0.0 ) ofRotateZDeg( rotation );
 				ofScale( scale.x, scale.y );
 				if(bUseShapeColor) ofSetColor( getColor() );
-				img.draw( 0, 0 );
+				if( atlasPage ) {
+					ttex->drawSubsection( 0, 0, atlasRect.width, atlasRect.height, atlasRect.x, atlasRect.y, atlasRect.width, atlasRect.height );
+				} else {
+					ttex->draw( 0, 0 );
+				}
 			} ofPopMatrix();
 		}
 	}
@@ -146,6 +556,7 @@ glm::vec2 Image::getAnchorPointForPercent( float ax, float ay ) {
 //--------------------------------------------------------------
 void Text::create() {
     meshes.clear();
+	mMeshBatches.clear();
     
     // now lets sort the text based on meshes that we need to create //
     vector< std::shared_ptr<TextSpan> > tspans = textSpans;
@@ -165,15 +576,7 @@ void Text::create() {
     }
     
     
-    bool bHasFontDirectory = false;
-//    cout << "checking directory: " << fdirectory+"/fonts/" << endl;
-    string fontsDirectory = ofToDataPath("", true);
-    if( fdirectory != "" ) {
-        fontsDirectory = fdirectory;//+"/fonts/";
-    }
-    if( ofFile::doesFileExist( fontsDirectory )) {
-        bHasFontDirectory = true;
-    }
+    string fontsDirectory = _getFontsDirectory();
     
 	std::map< string, std::map< int, vector< std::shared_ptr<TextSpan>> > >::iterator mainIt;
     for( mainIt = tspanFonts.begin(); mainIt != tspanFonts.end(); ++mainIt ) {
@@ -186,12 +589,17 @@ void Text::create() {
         // now create a mesh for the family //
         // map< string, map<int, ofMesh> > meshes;
         if( meshes.count(mainIt->first) == 0 ) {
-			std::map< int, ofMesh > tempMeshMap;
+			std::map< int, ofVboMesh > tempMeshMap;
             meshes[ mainIt->first ] = tempMeshMap;
         }
         
         Font& tfont = fonts[ mainIt->first ];
-		std::map< int, ofMesh >& meshMap = meshes[ mainIt->first ];
+		std::map< int, ofVboMesh >& meshMap = meshes[ mainIt->first ];
+        
+        if( bUseSdfFont ) {
+            _createSdfMeshes( mainIt->first, mainIt->second );
+            continue;
+        }
         
 		std::map< int, vector<std::shared_ptr<TextSpan>> >::iterator vIt;
         for( vIt = mainIt->second.begin(); vIt != mainIt->second.end(); ++vIt ) {
@@ -202,28 +610,11 @@ void Text::create() {
                 // first let's see if the fonts are provided. Some system fonts are .dfont that have several of the faces
                 // in them, but OF isn't setup to parse them, so we need each bold, regular, italic, etc to be a .ttf font //
 				string tfontPath = tfont.fontFamily;
-				if (bHasFontDirectory) {
-
-					ofLogNotice(moduleName()) << __FUNCTION__ << " : " << tfont.fontFamily << " : starting off searching directory : " << fontsDirectory;
-					string tNewFontPath = "";
-					bool bFoundTheFont = _recursiveFontDirSearch(fontsDirectory, tfont.fontFamily, tNewFontPath);
-					if (bFoundTheFont) {
-						tfontPath = tNewFontPath;
-					}
-
-					/*ofDirectory tfDir;
-					tfDir.listDir( fontsDirectory );
-					for( int ff = 0; ff < tfDir.size(); ff++ ) {
-						ofFile tfFile = tfDir.getFile(ff);
-						if( tfFile.getExtension() == "ttf" || tfFile.getExtension() == "otf" ) {
-							cout << ff << " - font family: " << tfont.fontFamily << " file name: " << tfFile.getBaseName() << endl;
-							if( ofToLower(tfFile.getBaseName()) == ofToLower(tfont.fontFamily) ) {
-								ofLogNotice(" >> ofxSvgText found font file for " ) << tfont.fontFamily;
-								tfontPath = tfFile.getAbsolutePath();
-								break;
-							}
-						}
-					}*/
+				// the directory is only scanned once, see FontIndex
+				string tNewFontPath = "";
+				if( FontIndex::sGetShared().find( fontsDirectory, tfont.fontFamily, tNewFontPath )) {
+					ofLogVerbose(moduleName()) << __FUNCTION__ << " : found font file for " << tfont.fontFamily;
+					tfontPath = tNewFontPath;
 				}
 
 				ofLogNotice(moduleName()) << __FUNCTION__ << " : Trying to load font from: " << tfontPath;
@@ -247,9 +638,19 @@ void Text::create() {
             if( !bFontLoadOk ) continue;
             
             if( meshMap.count(vIt->first) == 0 ) {
-                meshMap[ vIt->first ] = ofMesh();
+                meshMap[ vIt->first ] = ofVboMesh();
+            }
+            ofVboMesh& tmesh = meshMap[ vIt->first ];
+            tmesh.setUsage( GL_STATIC_DRAW );
+            
+            // when all of the spans share a color, it is applied as a tint when drawing instead of per vertex
+            bool bUniformColor = true;
+            for( auto& cspan : spanSpans ) {
+                if( cspan->color != spanSpans[0]->color ) {
+                    bUniformColor = false;
+                    break;
+                }
             }
-            ofMesh& tmesh = meshMap[ vIt->first ];
             
             if( !tfont.sizes.count( vIt->first ) ) {
 				ofLogError(moduleName()) << __FUNCTION__ << " : Could not find that font size in the map: " << vIt->first;
@@ -276,17 +677,44 @@ void Text::create() {
                     tsIndices[k] = tsIndices[k] + offsetIndex;
                 }
                 
-                ofFloatColor tcolor = cspan->color;
-                vector< ofFloatColor > tcolors;
-                tcolors.assign( stringMesh.getVertices().size(), tcolor );
-                
                 tmesh.addIndices( tsIndices );
                 tmesh.addVertices( stringMesh.getVertices() );
                 tmesh.addTexCoords( stringMesh.getTexCoords() );
-                tmesh.addColors( tcolors );
+                if( !bUniformColor ) {
+                    ofFloatColor tcolor = cspan->color;
+                    vector< ofFloatColor > tcolors;
+                    tcolors.assign( stringMesh.getVertices().size(), tcolor );
+                    tmesh.addColors( tcolors );
+                }
+            }
+            
+            if( tmesh.getNumVertices() < 1 ) continue;
+            
+            // resolve the texture once so drawing does not need to look up the fonts
+            MeshBatch tbatch;
+            tbatch.fontFamily = mainIt->first;
+            tbatch.fontSize = vIt->first;
+            tbatch.mesh = &tmesh;
+            if( tfont.textures.count( vIt->first )) {
+                tbatch.texture = &tfont.textures[ vIt->first ];
             }
+            tbatch.bUniformColor = bUniformColor;
+            if( bUniformColor && spanSpans.size() ) {
+                tbatch.color = spanSpans[0]->color;
+            } else {
+                tbatch.baseColors = tmesh.getColors();
+            }
+            mMeshBatches.push_back( tbatch );
         }
     }
+    mMeshBatchesOwner = this;
+    mBCreated = true;
+    
+    if( bUseSdfFont ) {
+        // no fonts were loaded, so measure the spans from the font files
+        measure();
+        return;
+    }
     
     // now loop through and set the width and height of the text spans //
     for( std::size_t i = 0; i < textSpans.size(); i++ ) {
@@ -302,73 +730,208 @@ void Text::create() {
             //tempSpan.rect.y         -= tempSpan.lineHeight;
         }
     }
+	// the span sizes changed, so the cached bounds of this text and its groups are stale
+	invalidateBounds();
+}
+
+//--------------------------------------------------------------
+void Text::_createSdfMeshes( const string& aFontFamily, std::map< int, vector< std::shared_ptr<TextSpan> > >& aSpansBySize ) {
+	auto& tatlas = sdfFonts[ aFontFamily ];
+	if( !tatlas ) {
+		string tfontPath = getFontPath( aFontFamily );
+		tatlas = std::make_shared<SdfFontAtlas>();
+		ofLogNotice(moduleName()) << __FUNCTION__ << " : Trying to load sdf font from: " << tfontPath;
+		if( !tatlas->setup( tfontPath )) {
+			ofLogError(moduleName()) << __FUNCTION__ << " : error loading sdf font family: " << aFontFamily;
+		}
+	}
+	if( !tatlas->isSetup() ) {
+		return;
+	}
+	
+	std::map< int, ofVboMesh >& meshMap = meshes[ aFontFamily ];
+	for( auto& vIt : aSpansBySize ) {
+		vector<std::shared_ptr<TextSpan>>& spanSpans = vIt.second;
+		ofVboMesh& tmesh = meshMap[ vIt.first ];
+		tmesh.setUsage( GL_STATIC_DRAW );
+		
+		bool bUniformColor = true;
+		for( auto& cspan : spanSpans ) {
+			if( cspan->color != spanSpans[0]->color ) {
+				bUniformColor = false;
+				break;
+			}
+		}
+		
+		for( auto& cspan : spanSpans ) {
+			if( cspan->text == "" ) continue;
+			std::size_t tnumVerts = tmesh.getNumVertices();
+			float tffontx = bCentered ? cspan->rect.x - tatlas->getStringWidth( cspan->text, vIt.first )/2 : cspan->rect.x;
+			tatlas->addStringMesh( cspan->text, tffontx, cspan->rect.y, vIt.first, tmesh );
+			if( !bUniformColor ) {
+				ofFloatColor tcolor = cspan->color;
+				vector< ofFloatColor > tcolors;
+				tcolors.assign( tmesh.getNumVertices() - tnumVerts, tcolor );
+				tmesh.addColors( tcolors );
+			}
+		}
+		
+		if( tmesh.getNumVertices() < 1 ) continue;
+		
+		MeshBatch tbatch;
+		tbatch.fontFamily = aFontFamily;
+		tbatch.fontSize = vIt.first;
+		tbatch.mesh = &tmesh;
+		tbatch.sdfAtlas = tatlas.get();
+		tbatch.bUniformColor = bUniformColor;
+		if( bUniformColor && spanSpans.size() ) {
+			tbatch.color = spanSpans[0]->color;
+		} else {
+			tbatch.baseColors = tmesh.getColors();
+		}
+		mMeshBatches.push_back( tbatch );
+	}
+}
+
+//--------------------------------------------------------------
+bool Text::measure() {
+	bool bAllMeasured = true;
+	for( auto& tspan : textSpans ) {
+		auto tface = FontMetrics::sGetShared().get( getFontPath( tspan->fontFamily ), tspan->fontSize );
+		if( !tface ) {
+			ofLogVerbose(moduleName()) << __FUNCTION__ << " : no font file for " << tspan->fontFamily << " size: " << tspan->fontSize;
+			bAllMeasured = false;
+			continue;
+		}
+		// same as the sizes set from the loaded fonts in create
+		ofRectangle tempBounds  = tface->getStringBoundingBox( tspan->text, 0, 0 );
+		tspan->rect.width       = tempBounds.width;
+		tspan->rect.height      = tempBounds.height;
+		tspan->lineHeight       = tface->getStringBoundingBox( "M", 0, 0 ).height;
+	}
+	invalidateBounds();
+	return bAllMeasured;
+}
+
+//--------------------------------------------------------------
+string Text::getFontPath( const string& aFontFamily ) {
+	string tfontPath = aFontFamily;
+	FontIndex::sGetShared().find( _getFontsDirectory(), aFontFamily, tfontPath );
+	return tfontPath;
+}
+
+//--------------------------------------------------------------
+string Text::_getFontsDirectory() {
+	if( fdirectory != "" ) {
+		return fdirectory;
+	}
+	return ofToDataPath("", true);
+}
+
+//--------------------------------------------------------------
+void Image::addMemoryUsage( MemoryUsage& aUsage ) {
+	Element::addMemoryUsage( aUsage );
+	// the pixels and textures are shared through the cache, MemoryStats counts them once per file
+	aUsage.strings += MemoryUsage::sGetNumBytes( filepath.native() );
+}
+
+//--------------------------------------------------------------
+void Text::addMemoryUsage( MemoryUsage& aUsage ) {
+	Rectangle::addMemoryUsage( aUsage );
+	aUsage.elements += MemoryUsage::sGetNumBytes( textSpans );
+	for( auto& tspan : textSpans ) {
+		if( !tspan ) continue;
+		aUsage.elements += sizeof(TextSpan);
+		aUsage.strings += MemoryUsage::sGetNumBytes( tspan->text );
+		aUsage.strings += MemoryUsage::sGetNumBytes( tspan->fontFamily );
+	}
+	aUsage.strings += MemoryUsage::sGetNumBytes( fdirectory );
+	
+	for( auto& tfamily : meshes ) {
+		aUsage.strings += MemoryUsage::sGetNumBytes( tfamily.first );
+		for( auto& tsize : tfamily.second ) {
+			aUsage.textMeshes += sizeof(tsize) + MemoryUsage::sGetNumBytes( tsize.second );
+		}
+	}
+	aUsage.textMeshes += MemoryUsage::sGetNumBytes( mMeshBatches );
+	for( auto& tbatch : mMeshBatches ) {
+		aUsage.textMeshes += MemoryUsage::sGetNumBytes( tbatch.baseColors );
+		aUsage.strings += MemoryUsage::sGetNumBytes( tbatch.fontFamily );
+	}
 }
 
 //--------------------------------------------------------------
 void Text::draw() {
     if( !isVisible() ) return;
-//    map< string, map<int, ofMesh> > meshes;
-    if(bUseShapeColor) {
-        ofSetColor( 255, 255, 255, 255.f * alpha );
+    if( !mBCreated ) {
+        create();
+    }
+    if( mMeshBatchesOwner != this ) {
+        _resolveMeshBatches();
     }
-	std::map< string, std::map<int, ofMesh> >::iterator mainIt;
     
     ofPushMatrix(); {
-        ofSetColor( 255, 0, 0 );
-        ofDrawCircle(pos, 6);
-        ofNoFill();
-//        ofSetColor( 0, 0, 224 );
-//        ofDrawCircle( ogPos, 10);
-        ofDrawRectangle(getRectangle());
-        ofFill();
-		
-//		ofLogNotice("ofx::svg2") << "Text: num text spans: " << textSpans.size() << " meshes size: " << meshes.size();
-        
         ofTranslate( pos.x, pos.y );
-        
-//        ofSetColor( 255, 255, 255, 255.f * alpha );
         if( rotation > 0 ) ofRotateZDeg( rotation );
-        ofTexture* tex = NULL;
-        for( mainIt = meshes.begin(); mainIt != meshes.end(); ++mainIt ) {
-            string fontFam = mainIt->first;
-			std::map< int, ofMesh >::iterator mIt;
-            for( mIt = meshes[ fontFam ].begin(); mIt != meshes[ fontFam ].end(); ++mIt ) {
-                int fontSize = mIt->first;
-                // let's check to make sure that the texture is there, so that we can bind it //
-                bool bHasTexture = false;
-                // static map< string, Font > fonts;
-                if( fonts.count( fontFam ) ) {
-                    if( fonts[ fontFam ].textures.count( fontSize ) ) {
-                        bHasTexture = true;
-                        tex = &fonts[ fontFam ].textures[ fontSize ];
-                    }
-                }
-                
-                if( bHasTexture ) tex->bind();
-                ofMesh& tMeshMesh = mIt->second;
-                if( bUseShapeColor ) {
-                    vector< ofFloatColor >& tcolors = tMeshMesh.getColors();
-                    for( auto& tc : tcolors ) {
-                        if( bOverrideColor ) {
-                            tc = _overrideColor;
-                        } else {
-                            tc.a = alpha;
-                        }
+        
+        for( auto& tbatch : mMeshBatches ) {
+            bool bVertexColors = !tbatch.bUniformColor;
+            if( bUseShapeColor ) {
+                if( bOverrideColor ) {
+                    ofSetColor( ofColor(_overrideColor) );
+                    bVertexColors = false;
+                } else if( tbatch.bUniformColor ) {
+                    ofFloatColor tcolor = tbatch.color;
+                    tcolor.a *= alpha;
+                    ofSetColor( ofColor(tcolor) );
+                } else if( tbatch.appliedAlpha != alpha ) {
+                    // only upload the colors again when the alpha has changed
+                    auto& tcolors = tbatch.mesh->getColors();
+                    for( std::size_t k = 0; k < tcolors.size() && k < tbatch.baseColors.size(); k++ ) {
+                        tcolors[k] = tbatch.baseColors[k];
+                        tcolors[k].a *= alpha;
                     }
-                } else {
-                    tMeshMesh.disableColors();
+                    tbatch.appliedAlpha = alpha;
                 }
-                tMeshMesh.draw();
-                if( bHasTexture ) tex->unbind();
-                tMeshMesh.enableColors();
+            } else {
+                // draw with the current color
+                bVertexColors = false;
+            }
+            
+            if( tbatch.sdfAtlas ) {
+                tbatch.sdfAtlas->begin( bVertexColors );
+            } else if( tbatch.texture ) {
+                tbatch.texture->bind();
+            }
+            if( !bVertexColors && !tbatch.bUniformColor ) {
+                tbatch.mesh->disableColors();
+                tbatch.mesh->draw();
+                tbatch.mesh->enableColors();
+            } else {
+                tbatch.mesh->draw();
+            }
+            if( tbatch.sdfAtlas ) {
+                tbatch.sdfAtlas->end();
+            } else if( tbatch.texture ) {
+                tbatch.texture->unbind();
             }
         }
     } ofPopMatrix();
-    
+}
+
+//--------------------------------------------------------------
+void Text::_resolveMeshBatches() {
+	for( auto& tbatch : mMeshBatches ) {
+		tbatch.mesh = &meshes[ tbatch.fontFamily ][ tbatch.fontSize ];
+	}
+	mMeshBatchesOwner = this;
 }
 
 //--------------------------------------------------------------
 void Text::draw(const std::string &astring, bool abCentered ) {
+	if( !mBCreated ) {
+		create();
+	}
 	if( textSpans.size() > 0 ) {
 		ofPushMatrix(); {
 			ofTranslate( pos.x, pos.y );
@@ -382,6 +945,9 @@ void Text::draw(const std::string &astring, bool abCentered ) {
 
 //--------------------------------------------------------------
 void Text::draw(const std::string& astring, const ofColor& acolor, bool abCentered ) {
+	if( !mBCreated ) {
+		create();
+	}
 	if( textSpans.size() > 0 ) {
 		ofPushMatrix(); {
 			ofTranslate( pos.x, pos.y );
@@ -393,43 +959,6 @@ void Text::draw(const std::string& astring, const ofColor& acolor, bool abCenter
 	}
 }
 
-//--------------------------------------------------------------
-bool Text::_recursiveFontDirSearch(const string& afile, const string& aFontFamToLookFor, string& fontpath) {
-	if (fontpath != "") {
-		return true;
-	}
-	ofFile tfFile( afile, ofFile::Reference );
-	if (tfFile.isDirectory()) {
-		ofLogVerbose(moduleName()) << __FUNCTION__ << " : searching in directory : " << afile << " | " << ofGetFrameNum();
-		ofDirectory tdir;
-		tdir.listDir(afile);
-		tdir.sort();
-		for (std::size_t i = 0; i < tdir.size(); i++) {
-			bool youGoodOrWhat = _recursiveFontDirSearch(tdir.getPath(i), aFontFamToLookFor, fontpath);
-            if( youGoodOrWhat ) {
-                return true;
-            }
-		}
-		tdir.close();
-	} else {
-		if ( tfFile.getExtension() == "ttf" || tfFile.getExtension() == "otf") {
-			if (ofToLower( tfFile.getBaseName() ) == ofToLower(aFontFamToLookFor)) {
-				ofLogNotice(moduleName()) << __FUNCTION__ << " : found font file for " << aFontFamToLookFor;
-				fontpath = tfFile.getAbsolutePath();
-				return true;
-			}
-			string tAltFileName = ofToLower(tfFile.getBaseName());
-			ofStringReplace(tAltFileName, " ", "-");
-			if (tAltFileName == ofToLower(aFontFamToLookFor)) {
-				ofLogNotice(moduleName()) << __FUNCTION__ << " : found font file for " << aFontFamToLookFor;
-				fontpath = tfFile.getAbsolutePath();
-				return true;
-			}
-		}
-	}
-    return false;
-}
-
 // must return a reference for some reason here //
 //--------------------------------------------------------------
 ofTrueTypeFont& Text::TextSpan::getFont() {
@@ -480,23 +1009,32 @@ ofColor Text::getColor() {
 // should be called after create //
 //--------------------------------------------------------------
 ofRectangle Text::getRectangle() {
-    ofRectangle temp( 0, 0, 1, 1 );
-    for( std::size_t i = 0; i < textSpans.size(); i++ ) {
-        ofRectangle trect = textSpans[i]->rect;
-        trect.x = trect.x;// - ogPos.x;
-        trect.y = trect.y;// - ogPos.y;
-        trect.y -= textSpans[i]->lineHeight;
-        if( i == 0 ) {
-            temp = trect;
-        } else {
-            temp.growToInclude( trect );
-        }
-    }
-    
-    
-    temp.x += pos.x;
-    temp.y += pos.y;
-    return temp;
+	if( mBSpanBoundsDirty || mNumSpansInBounds != textSpans.size() ) {
+		ofRectangle temp( 0, 0, 1, 1 );
+		for( std::size_t i = 0; i < textSpans.size(); i++ ) {
+			ofRectangle trect = textSpans[i]->rect;
+			trect.y -= textSpans[i]->lineHeight;
+			if( i == 0 ) {
+				temp = trect;
+			} else {
+				temp.growToInclude( trect );
+			}
+		}
+		mSpanBounds = temp;
+		mNumSpansInBounds = textSpans.size();
+		mBSpanBoundsDirty = false;
+	}
+	
+	ofRectangle temp = mSpanBounds;
+	temp.x += pos.x;
+	temp.y += pos.y;
+	return temp;
+}
+
+//--------------------------------------------------------------
+void Text::invalidateBounds() {
+	mBSpanBoundsDirty = true;
+	Element::invalidateBounds();
 }
 
 
@@ -10,8 +10,17 @@
 #include "ofPath.h"
 #include <map>
 #include "ofTrueTypeFont.h"
+#include "ofVboMesh.h"
+#include "ofxSvgImageCache.h"
+#include "ofxSvgLodBuilder.h"
+#include "ofxSvgSdfFontAtlas.h"
+#include "ofxSvgTextureAtlas.h"
+#include "ofxSvgStrokeTessellator.h"
 
 namespace ofx::svg {
+class Group;
+class MemoryUsage;
+
 enum SvgType {
 	TYPE_ELEMENT = 0,
 	TYPE_GROUP,
@@ -30,7 +39,9 @@ public:
 	
 	static std::string sGetTypeAsString(SvgType atype);
 	
-	virtual SvgType getType() {return TYPE_ELEMENT;}
+	// type tag for the class, so templates do not need an instance to query the type
+	static SvgType sGetType() {return TYPE_ELEMENT;}
+	virtual SvgType getType() {return sGetType();}
 	std::string getTypeAsString();
 	
 	std::string getName() { return name; }
@@ -42,8 +53,13 @@ public:
 	bool isVisible() { return bVisible; }
 	
 	virtual std::string toString(int nlevel = 0);
+	// adds the bytes held by the element, not counting the size of the object itself or shared images, see Parser::getMemoryStats
+	virtual void addMemoryUsage( MemoryUsage& aUsage );
 	
 	std::string name = "";
+	// id of the name in the string table of the document, see Parser::getStringTable.
+	// Set when loading, call Parser::internStrings() after renaming elements.
+	uint32_t nameId = 0;
 	float layer = -1.f;
 	bool bVisible=true;
 	bool bUseShapeColor = true;
@@ -70,21 +86,80 @@ public:
 		return ofPolyline();
 	}
 	
+	// the group that contains this element, set when the element is added to a group.
+	// non-owning, will be nullptr for root elements and defs.
+	Group* getParent() { return mParent; }
+	
+	// bounds in the coordinates of the parent group, computed from the geometry and transform on the first call and cached.
+	// Call invalidateBounds() after changing the geometry or moving the element.
+	ofRectangle getLocalBounds();
+	// bounds in document space, the local bounds moved by the positions of the parent groups
+	ofRectangle getGlobalBounds();
+	// false for elements without geometry, their bounds are empty rectangles
+	bool hasBounds();
+	// marks the cached bounds of this element and of all of its parent groups as dirty
+	virtual void invalidateBounds();
 	
+protected:
+	friend class Group;
+	Group* mParent = nullptr;
+	
+	// computes the local bounds without caching them
+	virtual bool _computeLocalBounds( ofRectangle& aBounds );
+	void _updateLocalBounds();
+	ofRectangle mLocalBounds;
+	bool mBHasLocalBounds = false;
+	bool mBLocalBoundsDirty = true;
 };
 
 class Path : public Element {
 public:
-	virtual SvgType getType() override {return TYPE_PATH;}
+	static SvgType sGetType() {return TYPE_PATH;}
+	virtual SvgType getType() override {return sGetType();}
 	
 	virtual void setUseShapeColor( bool ab ) override {
 		Element::setUseShapeColor(ab);
 		path.setUseShapeColor(ab);
 	}
 	
-	virtual void draw() override {
-		if(isVisible()) path.draw();
-	}
+	virtual void draw() override;
+	virtual void addMemoryUsage( MemoryUsage& aUsage ) override;
+	
+	// level of detail, draws simplified copies of the outlines when the path covers few pixels on screen.
+	// Level n is simplified with a tolerance of aBaseTolerance * 4^(n-1) document units and is used once
+	// that tolerance is below half a pixel. The levels are built on the shared LodBuilder workers on the first draw.
+	void setLodEnabled( bool ab, int aNumLevels = 4, float aBaseTolerance = 0.5f );
+	bool isLodEnabled() { return mBLodEnabled; }
+	// builds the levels now instead of on the first draw
+	void buildLods( bool abAsync = false );
+	// call after changing the path so that the levels are built again
+	void clearLods();
+	// 0 is the full path
+	int getCurrentLod() { return mCurrentLod; }
+	std::size_t getNumLods() { return mLods.size(); }
+	std::size_t getNumVerticesForLod( int aLevel );
+	// the scale has to move this far past a threshold before the level changes, to avoid popping
+	void setLodHysteresis( float aHysteresis ) { mLodHysteresis = std::max( 0.f, aHysteresis ); }
+	// selects the level for a scale in pixels per document unit, called from draw
+	void updateLod( float aPixelScale );
+	// pixels per document unit for the current matrices and viewport
+	static float sGetCurrentPixelScale();
+	
+	// replaces the path with its outlines simplified within aTolerance document units. Nearly collinear segments
+	// are merged first and the remaining points are reduced with ofPolyline::simplify ( Ramer Douglas Peucker ).
+	// Curves are flattened to line segments. Clears the levels of detail and the stroke mesh.
+	void simplify( float aTolerance );
+	
+	// draws the stroke as triangles tessellated on the cpu with the width, joins and caps of the stroke style,
+	// instead of gl lines that ignore the width on most core profiles.
+	void setStrokeTessellationEnabled( bool ab ) { mBTessellateStroke = ab; }
+	bool isStrokeTessellationEnabled() { return mBTessellateStroke; }
+	void setStrokeStyle( const StrokeStyle& aStyle ) { mStrokeStyle = aStyle; }
+	const StrokeStyle& getStrokeStyle() { return mStrokeStyle; }
+	// the cached stroke triangles in the coordinates of the outlines. Tessellated again when the stroke width
+	// or style has changed since the last call, call clearStrokeMesh() after changing the outlines.
+	ofVboMesh& getStrokeMesh();
+	void clearStrokeMesh() { mBStrokeMeshDirty = true; }
 	
 	bool isFilled() { return path.isFilled(); }
 	bool hasStroke() { return path.hasOutline(); }
@@ -101,11 +176,42 @@ public:
 	}
 	
 	ofPath path;
+	
+protected:
+	typedef LodBuilder::Outlines LodOutlines;
+	class Lod {
+	public:
+		float tolerance = 0.f;
+		ofPath path;
+		std::size_t numVertices = 0;
+	};
+	static LodOutlines _sSimplifyOutlines( std::vector<ofPolyline> aOutlines, int aNumLevels, float aBaseTolerance );
+	// drops the points that are within aTolerance of the segments between the points that are kept
+	static void _sMergeCollinear( ofPolyline& aLine, float aTolerance );
+	void _setLods( const LodOutlines& aOutlines );
+	
+	std::vector<Lod> mLods;
+	// simplified outlines being built on a worker, releasing it cancels the build
+	std::shared_ptr<LodBuilder::Job> mLodJob;
+	bool mBLodEnabled = false;
+	int mNumLodLevels = 4;
+	float mLodBaseTolerance = 0.5f;
+	float mLodHysteresis = 0.25f;
+	int mCurrentLod = 0;
+	
+	StrokeStyle mStrokeStyle;
+	bool mBTessellateStroke = false;
+	ofVboMesh mStrokeMesh;
+	bool mBStrokeMeshDirty = true;
+	// style that the mesh was tessellated with
+	StrokeStyle mStrokeMeshStyle;
+	float mStrokeMeshWidth = 0.f;
 };
 
 class Rectangle : public Path {
 public:
-	virtual SvgType getType() override {return TYPE_RECTANGLE;}
+	static SvgType sGetType() {return TYPE_RECTANGLE;}
+	virtual SvgType getType() override {return sGetType();}
 	ofRectangle rectangle;
 	
 	float getWidth() { return rectangle.getWidth() * scale.x;}
@@ -117,7 +223,8 @@ public:
 
 class Image : public Element {
 public:
-	virtual SvgType getType() override {return TYPE_IMAGE;}
+	static SvgType sGetType() {return TYPE_IMAGE;}
+	virtual SvgType getType() override {return sGetType();}
 	
 	float getWidth() { return width * scale.x;}
 	float getHeight() { return height * scale.y;}
@@ -126,7 +233,23 @@ public:
 //	float getWidthScaled() { return getWidth() * scale.x;}
 //	float getHeightScaled() { return getHeight() * scale.y;}
 	
+	// decodes the image through the shared ImageCache, blocking until the pixels are ready,
+	// and uploads the texture. Also fills the deprecated img. Returns true if the texture is allocated.
+	bool load();
+	// true once the pixels have been decoded, does not block
+	bool isLoaded();
+	// requests the file from the ImageCache if it has not been requested yet
+	std::shared_ptr<ImageCache::Entry> getCacheEntry( bool abAsync = true );
+	// uploads the texture on the first call, nullptr while the image is still decoding.
+	// This is the atlas page when the image has been packed into an atlas.
+	ofTexture* getTexture();
+	// area of the texture to draw in pixels, the whole image unless it is in an atlas
+	ofRectangle getTextureRect();
+	// images with the same key draw from the same texture
+	const void* getTextureKey();
+	bool isInAtlas() { return atlasPage != nullptr; }
 	virtual void draw() override;
+	virtual void addMemoryUsage( MemoryUsage& aUsage ) override;
 	glm::vec2 getAnchorPointForPercent( float ax, float ay );
 	
 	std::string getFilePath() { return filepath.string(); }
@@ -139,6 +262,13 @@ public:
 	}
 	
 	ofColor color;
+	// shared with all of the images with the same file path
+	std::shared_ptr<ImageCache::Entry> cacheEntry;
+	// set when packed into an atlas, see Parser::setImageAtlasEnabled
+	std::shared_ptr<TextureAtlas::Page> atlasPage;
+	ofRectangle atlasRect;
+	// deprecated, the images are drawn from the cacheEntry. Only filled by load() for code written
+	// against the previous versions, as a copy of the cached pixels. Use getTexture() or getCacheEntry() instead.
 	ofImage img;
 	bool bTryLoad = false;
 	of::filesystem::path filepath;
@@ -148,14 +278,16 @@ public:
 
 class Circle : public Path {
 public:
-	virtual SvgType getType() override {return TYPE_CIRCLE;}
+	static SvgType sGetType() {return TYPE_CIRCLE;}
+	virtual SvgType getType() override {return sGetType();}
 	float getRadius() {return radius;}
 	float radius = 10.0;
 };
 
 class Ellipse : public Path {
 public:
-	virtual SvgType getType() override {return TYPE_ELLIPSE;}
+	static SvgType sGetType() {return TYPE_ELLIPSE;}
+	virtual SvgType getType() override {return sGetType();}
 	float radiusX, radiusY = 10.0f;
 };
 
@@ -170,6 +302,8 @@ public:
 	};
 	
 	static std::map< std::string, Font > fonts;
+	// one signed distance field atlas per family, serving all of the sizes, see bUseSdfFont
+	static std::map< std::string, std::shared_ptr<SdfFontAtlas> > sdfFonts;
 	
 	class TextSpan {
 	public:
@@ -182,6 +316,8 @@ public:
 		std::string text;
 		int fontSize = 12;
 		std::string fontFamily;
+		// id of the font family in the string table of the document
+		uint32_t fontFamilyId = 0;
 		ofRectangle rect;
 		ofColor color;
 		float lineHeight = 12;
@@ -199,13 +335,23 @@ public:
 	}
 	
 //	Text() { type = OFX_SVG_TYPE_TEXT; fdirectory=""; bCentered=false; alpha=1.0; bOverrideColor=false; }
-	virtual SvgType getType() override {return TYPE_TEXT;}
+	static SvgType sGetType() {return TYPE_TEXT;}
+	virtual SvgType getType() override {return sGetType();}
 	
 	ofTrueTypeFont& getFont();
 	ofColor getColor();
 	
+	// loads the fonts, builds the meshes and sets the span sizes. Called on the first draw if it has not been called yet,
+	// so text loaded with Parser::setDeferTextCreation has empty span sizes until then, unless measure() was called.
 	void create();
+	bool isCreated() { return mBCreated; }
+	// fills in the span sizes and line heights from the font files with FreeType,
+	// without loading the fonts or creating textures, so it can run without a gl context
+	bool measure();
+	// font file for the family in the font directory, or the family name when there is no file for it
+	std::string getFontPath( const std::string& aFontFamily );
 	void draw() override;
+	void addMemoryUsage( MemoryUsage& aUsage ) override;
 	void draw(const std::string &astring, bool abCentered );
 	void draw(const std::string &astring, const ofColor& acolor, bool abCentered );
 	
@@ -219,19 +365,52 @@ public:
 		_overrideColor = aColor;
 	}
 	
+	// bounds of the spans moved by the position, the union of the spans is cached until
+	// the spans are measured again or the number of spans changes
 	ofRectangle getRectangle();
+	virtual void invalidateBounds() override;
 	
-	std::map< std::string, std::map<int, ofMesh> > meshes;
+	// one mesh per font family and size, uploaded once in create
+	std::map< std::string, std::map<int, ofVboMesh> > meshes;
 	std::vector< std::shared_ptr<TextSpan> > textSpans;
 	
 	std::string fdirectory;
 	bool bCentered = false;
+	// build the meshes from the shared sdf atlas of the family instead of loading a font per size
+	bool bUseSdfFont = false;
 	float alpha = 1.;
 	glm::vec2 ogPos = glm::vec2(0.f, 0.f);
 	
 protected:
+	// a mesh and the font texture it is drawn with, resolved in create so draw does not look up the fonts
+	class MeshBatch {
+	public:
+		std::string fontFamily;
+		int fontSize = 0;
+		ofVboMesh* mesh = nullptr;
+		ofTexture* texture = nullptr;
+		SdfFontAtlas* sdfAtlas = nullptr;
+		// spans with a single color are tinted when drawing and do not store vertex colors
+		bool bUniformColor = true;
+		ofFloatColor color;
+		// span colors for meshes with several colors, alpha is applied to them when it changes
+		std::vector<ofFloatColor> baseColors;
+		float appliedAlpha = 1.f;
+	};
+	bool mBCreated = false;
+	std::vector<MeshBatch> mMeshBatches;
+	// the text that the mesh pointers refer to, copies ( <use> ) point them at their own meshes on draw
+	const Text* mMeshBatchesOwner = nullptr;
+	void _resolveMeshBatches();
+	std::string _getFontsDirectory();
+	void _createSdfMeshes( const std::string& aFontFamily, std::map< int, std::vector< std::shared_ptr<TextSpan> > >& aSpansBySize );
+	
+	
+	ofRectangle mSpanBounds;
+	bool mBSpanBoundsDirty = true;
+	std::size_t mNumSpansInBounds = 0;
+	
 	static ofTrueTypeFont defaultFont;
-	bool _recursiveFontDirSearch(const std::string& afile, const std::string& aFontFamToLookFor, std::string& fontpath);
 	ofFloatColor _overrideColor;
 	bool bOverrideColor = false;
 };
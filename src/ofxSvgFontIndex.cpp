@@ -0,0 +1,261 @@
+//
+//  ofxSvgFontIndex.cpp
+//
+
+#include "ofxSvgFontIndex.h"
+#include "ofUtils.h"
+#include "ofLog.h"
+#include <algorithm>
+#include <sstream>
+
+using namespace ofx::svg;
+using std::string;
+using std::vector;
+
+//--------------------------------------------------------------
+FontIndex& FontIndex::sGetShared() {
+	static FontIndex sIndex;
+	return sIndex;
+}
+
+//--------------------------------------------------------------
+bool FontIndex::find( const string& aDirectory, const string& aFontFamily, string& aFontPath ) {
+	auto tindex = _getIndex( aDirectory );
+	if( !tindex ) {
+		return false;
+	}
+	auto it = tindex->exactNames.find( ofToLower( aFontFamily ));
+	if( it != tindex->exactNames.end() ) {
+		aFontPath = it->second;
+		return true;
+	}
+	it = tindex->looseNames.find( _getLooseName( aFontFamily ));
+	if( it != tindex->looseNames.end() ) {
+		aFontPath = it->second;
+		return true;
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+void FontIndex::invalidate( const string& aDirectory ) {
+	mIndices.erase( _getKey( aDirectory ));
+}
+
+//--------------------------------------------------------------
+void FontIndex::clear() {
+	mIndices.clear();
+}
+
+//--------------------------------------------------------------
+void FontIndex::setCacheFile( const of::filesystem::path& aPath ) {
+	mCacheFilePath = aPath;
+	mBCacheFileLoaded = false;
+}
+
+//--------------------------------------------------------------
+std::size_t FontIndex::getNumFonts( const string& aDirectory ) {
+	auto tindex = _getIndex( aDirectory );
+	return tindex ? tindex->fontPaths.size() : 0;
+}
+
+//--------------------------------------------------------------
+bool FontIndex::save() {
+	if( mCacheFilePath.empty() ) {
+		return false;
+	}
+	std::ostringstream tout;
+	tout << "ofxSvgFontIndex 1\n";
+	for( auto& it : mIndices ) {
+		tout << "index " << it.first << "\n";
+		for( auto& tdir : it.second.directories ) {
+			tout << "dir " << tdir.second << " " << tdir.first << "\n";
+		}
+		for( auto& tpath : it.second.fontPaths ) {
+			tout << "font " << tpath << "\n";
+		}
+	}
+	string tstr = tout.str();
+	ofBuffer tbuffer( tstr.data(), tstr.size() );
+	if( !ofBufferToFile( mCacheFilePath, tbuffer )) {
+		ofLogWarning(moduleName()) << __FUNCTION__ << " : unable to write font cache file " << mCacheFilePath.string();
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+string FontIndex::_getKey( const string& aDirectory ) {
+	string tkey = of::filesystem::path( aDirectory ).lexically_normal().generic_string();
+	while( tkey.size() > 1 && tkey.back() == '/' ) {
+		tkey.pop_back();
+	}
+	return tkey;
+}
+
+//--------------------------------------------------------------
+string FontIndex::_getLooseName( const string& aName ) {
+	string tname;
+	tname.reserve( aName.size() );
+	for( char c : aName ) {
+		if( c == ' ' || c == '-' || c == '_' ) continue;
+		tname += (char)std::tolower( (unsigned char)c );
+	}
+	return tname;
+}
+
+//--------------------------------------------------------------
+long long FontIndex::_getModifiedTime( const of::filesystem::path& aPath ) {
+	std::error_code ec;
+	auto ttime = of::filesystem::last_write_time( aPath, ec );
+	if( ec ) {
+		return -1;
+	}
+	return (long long)ttime.time_since_epoch().count();
+}
+
+//--------------------------------------------------------------
+FontIndex::DirectoryIndex* FontIndex::_getIndex( const string& aDirectory ) {
+	if( aDirectory.empty() ) {
+		return nullptr;
+	}
+	if( !mBCacheFileLoaded ) {
+		_loadCacheFile();
+	}
+
+	string tkey = _getKey( aDirectory );
+	auto it = mIndices.find( tkey );
+	if( it != mIndices.end() ) {
+		// indices read from the cache file are checked once against the directory times
+		if( it->second.bChecked || _isValid( it->second )) {
+			it->second.bChecked = true;
+			return &it->second;
+		}
+		ofLogVerbose(moduleName()) << __FUNCTION__ << " : cached index is out of date for " << tkey;
+	}
+
+	DirectoryIndex tindex;
+	std::error_code ec;
+	if( of::filesystem::is_directory( aDirectory, ec )) {
+		ofLogVerbose(moduleName()) << __FUNCTION__ << " : scanning font directory " << tkey;
+		_scanRecursive( aDirectory, tindex );
+	}
+	_buildNames( tindex );
+	tindex.bChecked = true;
+	auto& rindex = mIndices[ tkey ];
+	rindex = std::move( tindex );
+	if( !mCacheFilePath.empty() ) {
+		save();
+	}
+	return &rindex;
+}
+
+//--------------------------------------------------------------
+void FontIndex::_scanRecursive( const of::filesystem::path& aPath, DirectoryIndex& aIndex ) {
+	aIndex.directories.push_back( std::make_pair( aPath.string(), _getModifiedTime( aPath )));
+
+	vector< of::filesystem::path > tentries;
+	std::error_code ec;
+	for( of::filesystem::directory_iterator dit( aPath, ec ), dend; !ec && dit != dend; dit.increment( ec )) {
+		auto tname = dit->path().filename().string();
+		// hidden files are skipped, same as ofDirectory
+		if( tname.size() && tname[0] == '.' ) continue;
+		tentries.push_back( dit->path() );
+	}
+	std::sort( tentries.begin(), tentries.end() );
+
+	for( auto& tentry : tentries ) {
+		if( of::filesystem::is_directory( tentry, ec )) {
+			_scanRecursive( tentry, aIndex );
+		} else {
+			auto text = ofToLower( tentry.extension().string() );
+			if( text == ".ttf" || text == ".otf" ) {
+				aIndex.fontPaths.push_back( of::filesystem::absolute( tentry, ec ).string() );
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void FontIndex::_buildNames( DirectoryIndex& aIndex ) {
+	aIndex.exactNames.clear();
+	aIndex.looseNames.clear();
+	for( auto& tpath : aIndex.fontPaths ) {
+		string tbase = of::filesystem::path( tpath ).stem().string();
+		// emplace keeps the first font in the sorted order
+		string tlower = ofToLower( tbase );
+		aIndex.exactNames.emplace( tlower, tpath );
+		string tdashed = tlower;
+		std::replace( tdashed.begin(), tdashed.end(), ' ', '-' );
+		aIndex.exactNames.emplace( tdashed, tpath );
+
+		string tloose = _getLooseName( tbase );
+		aIndex.looseNames.emplace( tloose, tpath );
+		const string tregular = "regular";
+		if( tloose.size() > tregular.size() && tloose.compare( tloose.size() - tregular.size(), tregular.size(), tregular ) == 0 ) {
+			aIndex.looseNames.emplace( tloose.substr( 0, tloose.size() - tregular.size() ), tpath );
+		}
+	}
+}
+
+//--------------------------------------------------------------
+bool FontIndex::_isValid( DirectoryIndex& aIndex ) {
+	if( aIndex.directories.empty() ) {
+		return false;
+	}
+	for( auto& tdir : aIndex.directories ) {
+		if( _getModifiedTime( tdir.first ) != tdir.second ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool FontIndex::_loadCacheFile() {
+	mBCacheFileLoaded = true;
+	if( mCacheFilePath.empty() ) {
+		return false;
+	}
+	std::error_code ec;
+	if( !of::filesystem::exists( mCacheFilePath, ec )) {
+		return false;
+	}
+
+	ofBuffer tbuffer = ofBufferFromFile( mCacheFilePath );
+	std::istringstream tin( tbuffer.getText() );
+	string tline;
+	if( !std::getline( tin, tline ) || tline != "ofxSvgFontIndex 1" ) {
+		ofLogWarning(moduleName()) << __FUNCTION__ << " : ignoring unknown font cache file " << mCacheFilePath.string();
+		return false;
+	}
+
+	DirectoryIndex* tindex = nullptr;
+	while( std::getline( tin, tline )) {
+		if( tline.compare( 0, 6, "index " ) == 0 ) {
+			string tkey = tline.substr( 6 );
+			// directories scanned this session are newer than the file
+			if( mIndices.count( tkey )) {
+				tindex = nullptr;
+			} else {
+				tindex = &mIndices[ tkey ];
+			}
+		} else if( !tindex ) {
+			continue;
+		} else if( tline.compare( 0, 4, "dir " ) == 0 ) {
+			auto tspace = tline.find( ' ', 4 );
+			if( tspace == string::npos ) continue;
+			long long ttime = std::atoll( tline.substr( 4, tspace - 4 ).c_str() );
+			tindex->directories.push_back( std::make_pair( tline.substr( tspace + 1 ), ttime ));
+		} else if( tline.compare( 0, 5, "font " ) == 0 ) {
+			tindex->fontPaths.push_back( tline.substr( 5 ));
+		}
+	}
+
+	for( auto& it : mIndices ) {
+		if( !it.second.bChecked ) {
+			_buildNames( it.second );
+		}
+	}
+	return true;
+}
@@ -0,0 +1,64 @@
+//
+//  ofxSvgFontIndex.h
+//
+//  Maps font family names to font files. Each font directory is scanned once and the
+//  result can be persisted to a cache file, which is reused while the modification
+//  times of the scanned directories have not changed.
+//
+
+#pragma once
+#include "ofFileUtils.h"
+#include <unordered_map>
+
+namespace ofx::svg {
+class FontIndex {
+public:
+	// index shared by all of the documents, like the fonts in Text
+	static FontIndex& sGetShared();
+
+	// finds the ttf or otf file for the family below aDirectory, scanning the directory on the first call.
+	// Matches the lowercase file name, with spaces as dashes, and then loosely ignoring spaces, dashes,
+	// underscores and a "regular" suffix. The first file in sorted order wins.
+	bool find( const std::string& aDirectory, const std::string& aFontFamily, std::string& aFontPath );
+
+	// scans again on the next find
+	void invalidate( const std::string& aDirectory );
+	void clear();
+
+	// file to persist the scanned directories to, it is read on the first scan and written after new scans
+	void setCacheFile( const of::filesystem::path& aPath );
+	bool save();
+
+	std::size_t getNumFonts( const std::string& aDirectory );
+
+	// will log messages to this module name
+	static const std::string moduleName() { return "ofx::svg::FontIndex"; }
+
+protected:
+	struct DirectoryIndex {
+		// every directory that was scanned, with its modification time, to validate the cache
+		std::vector< std::pair< std::string, long long > > directories;
+		std::vector< std::string > fontPaths;
+		// lowercase base name and the variant with spaces as dashes
+		std::unordered_map< std::string, std::string > exactNames;
+		// lowercase without spaces, dashes and underscores
+		std::unordered_map< std::string, std::string > looseNames;
+		// false for indices read from the cache file until the directory times have been checked
+		bool bChecked = false;
+	};
+
+	static std::string _getKey( const std::string& aDirectory );
+	static std::string _getLooseName( const std::string& aName );
+	static long long _getModifiedTime( const of::filesystem::path& aPath );
+
+	DirectoryIndex* _getIndex( const std::string& aDirectory );
+	void _scanRecursive( const of::filesystem::path& aPath, DirectoryIndex& aIndex );
+	void _buildNames( DirectoryIndex& aIndex );
+	bool _isValid( DirectoryIndex& aIndex );
+	bool _loadCacheFile();
+
+	std::unordered_map< std::string, DirectoryIndex > mIndices;
+	of::filesystem::path mCacheFilePath;
+	bool mBCacheFileLoaded = false;
+};
+}
@@ -0,0 +1,244 @@
+//
+//  ofxSvgFontMetrics.cpp
+//
+
+#include "ofxSvgFontMetrics.h"
+#include "ofUtils.h"
+#include "ofLog.h"
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <limits>
+#include <algorithm>
+
+using namespace ofx::svg;
+using std::shared_ptr;
+using std::string;
+
+// same as ofTrueTypeFont
+static const int sTabWidth = 4;
+
+//--------------------------------------------------------------
+FontMetrics::Face::~Face() {
+	if( mFace ) {
+		FT_Done_Face( mFace );
+		mFace = nullptr;
+	}
+}
+
+//--------------------------------------------------------------
+FontMetrics::Glyph FontMetrics::Face::getGlyph( uint32_t aCodepoint ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return _getGlyph( aCodepoint );
+}
+
+//--------------------------------------------------------------
+const FontMetrics::Glyph& FontMetrics::Face::_getGlyph( uint32_t aCodepoint ) {
+	auto it = mGlyphs.find( aCodepoint );
+	if( it != mGlyphs.end() ) {
+		return it->second;
+	}
+	Glyph tglyph;
+	if( mFace ) {
+		tglyph.index = FT_Get_Char_Index( mFace, aCodepoint );
+		if( FT_Load_Glyph( mFace, tglyph.index, FT_LOAD_DEFAULT ) == 0 ) {
+			auto& tmetrics = mFace->glyph->metrics;
+			tglyph.advance = (float)tmetrics.horiAdvance / 64.f;
+			tglyph.bearingX = (float)tmetrics.horiBearingX / 64.f;
+			tglyph.bearingY = (float)tmetrics.horiBearingY / 64.f;
+			tglyph.width = (float)tmetrics.width / 64.f;
+			tglyph.height = (float)tmetrics.height / 64.f;
+		} else {
+			ofLogVerbose(moduleName()) << __FUNCTION__ << " : unable to load glyph " << aCodepoint << " from " << mPath;
+		}
+	}
+	return mGlyphs.emplace( aCodepoint, tglyph ).first->second;
+}
+
+//--------------------------------------------------------------
+ofRectangle FontMetrics::Face::getStringBoundingBox( const string& aUtf8String, float x, float y ) {
+	if( aUtf8String.empty() ) {
+		return ofRectangle( x, y, 0, 0 );
+	}
+	std::lock_guard<std::mutex> lock( mMutex );
+
+	float minX = std::numeric_limits<float>::max();
+	float minY = std::numeric_limits<float>::max();
+	float maxX = -std::numeric_limits<float>::max();
+	float maxY = -std::numeric_limits<float>::max();
+	bool bHasGlyphs = false;
+
+	float penX = x;
+	float penY = y;
+	unsigned int prevIndex = 0;
+	for( auto c : ofUTF8Iterator( aUtf8String )) {
+		if( c == '\n' ) {
+			penX = x;
+			penY += mLineHeight;
+			prevIndex = 0;
+			continue;
+		}
+		if( c == '\t' ) {
+			penX += _getGlyph( ' ' ).advance * sTabWidth;
+			prevIndex = 0;
+			continue;
+		}
+		const Glyph& tglyph = _getGlyph( c );
+		penX += _getKerning( prevIndex, tglyph.index );
+		if( tglyph.width > 0.f && tglyph.height > 0.f ) {
+			minX = std::min( minX, penX + tglyph.bearingX );
+			maxX = std::max( maxX, penX + tglyph.bearingX + tglyph.width );
+			minY = std::min( minY, penY - tglyph.bearingY );
+			maxY = std::max( maxY, penY - tglyph.bearingY + tglyph.height );
+			bHasGlyphs = true;
+		}
+		penX += tglyph.advance;
+		prevIndex = tglyph.index;
+	}
+
+	if( !bHasGlyphs ) {
+		// only white space
+		return ofRectangle( x, y, penX - x, 0 );
+	}
+	return ofRectangle( minX, minY, maxX - minX, maxY - minY );
+}
+
+//--------------------------------------------------------------
+float FontMetrics::Face::getStringWidth( const string& aUtf8String ) {
+	return getStringBoundingBox( aUtf8String, 0, 0 ).width;
+}
+
+//--------------------------------------------------------------
+float FontMetrics::Face::getKerning( unsigned int aLeftIndex, unsigned int aRightIndex ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return _getKerning( aLeftIndex, aRightIndex );
+}
+
+//--------------------------------------------------------------
+float FontMetrics::Face::_getKerning( unsigned int aLeftIndex, unsigned int aRightIndex ) {
+	if( !mBHasKerning || !aLeftIndex || !aRightIndex ) {
+		return 0.f;
+	}
+	FT_Vector tkerning;
+	if( FT_Get_Kerning( mFace, aLeftIndex, aRightIndex, FT_KERNING_UNFITTED, &tkerning ) != 0 ) {
+		return 0.f;
+	}
+	return (float)tkerning.x / 64.f;
+}
+
+//--------------------------------------------------------------
+bool FontMetrics::Face::renderGlyph( uint32_t aCodepoint, std::vector<unsigned char>& aCoverage, int& aWidth, int& aHeight, int& aLeft, int& aTop ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+	aWidth = aHeight = aLeft = aTop = 0;
+	aCoverage.clear();
+	if( !mFace ) {
+		return false;
+	}
+	auto tindex = _getGlyph( aCodepoint ).index;
+	if( FT_Load_Glyph( mFace, tindex, FT_LOAD_DEFAULT ) != 0 ) {
+		return false;
+	}
+	if( FT_Render_Glyph( mFace->glyph, FT_RENDER_MODE_NORMAL ) != 0 ) {
+		ofLogVerbose(moduleName()) << __FUNCTION__ << " : unable to render glyph " << aCodepoint << " from " << mPath;
+		return false;
+	}
+	auto& tbitmap = mFace->glyph->bitmap;
+	if( tbitmap.width < 1 || tbitmap.rows < 1 || tbitmap.pixel_mode != FT_PIXEL_MODE_GRAY ) {
+		return false;
+	}
+	aWidth = (int)tbitmap.width;
+	aHeight = (int)tbitmap.rows;
+	aLeft = mFace->glyph->bitmap_left;
+	aTop = mFace->glyph->bitmap_top;
+	aCoverage.resize( (std::size_t)aWidth * aHeight );
+	for( int y = 0; y < aHeight; y++ ) {
+		const unsigned char* trow = tbitmap.buffer + (std::ptrdiff_t)y * tbitmap.pitch;
+		std::copy( trow, trow + aWidth, aCoverage.begin() + (std::size_t)y * aWidth );
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+std::size_t FontMetrics::Face::getNumCachedGlyphs() {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mGlyphs.size();
+}
+
+#pragma mark - FontMetrics
+
+//--------------------------------------------------------------
+FontMetrics& FontMetrics::sGetShared() {
+	static FontMetrics sMetrics;
+	return sMetrics;
+}
+
+//--------------------------------------------------------------
+FontMetrics::~FontMetrics() {
+	// the faces have to be released before the library
+	mFaces.clear();
+	if( mLibrary ) {
+		FT_Done_FreeType( mLibrary );
+		mLibrary = nullptr;
+	}
+}
+
+//--------------------------------------------------------------
+shared_ptr<FontMetrics::Face> FontMetrics::get( const string& aFontPath, int aFontSize, int aDpi ) {
+	if( aFontPath.empty() || aFontSize < 1 ) {
+		return nullptr;
+	}
+	string tkey = aFontPath + "@" + ofToString( aFontSize ) + "@" + ofToString( aDpi );
+
+	std::lock_guard<std::mutex> lock( mMutex );
+	auto it = mFaces.find( tkey );
+	if( it != mFaces.end() ) {
+		return it->second;
+	}
+
+	if( !mLibrary && !mBLibraryFailed ) {
+		if( FT_Init_FreeType( &mLibrary ) != 0 ) {
+			ofLogError(moduleName()) << __FUNCTION__ << " : unable to initialize FreeType";
+			mLibrary = nullptr;
+			mBLibraryFailed = true;
+		}
+	}
+	if( !mLibrary ) {
+		return nullptr;
+	}
+
+	auto tface = std::make_shared<Face>();
+	tface->mPath = aFontPath;
+	tface->mFontSize = aFontSize;
+	if( FT_New_Face( mLibrary, aFontPath.c_str(), 0, &tface->mFace ) != 0 ) {
+		ofLogError(moduleName()) << __FUNCTION__ << " : unable to load font file " << aFontPath;
+		tface->mFace = nullptr;
+		// remember the failure so the file is not opened again
+		mFaces[ tkey ] = nullptr;
+		return nullptr;
+	}
+	// same char size as ofTrueTypeFont::load
+	FT_Set_Char_Size( tface->mFace, aFontSize << 6, aFontSize << 6, aDpi, aDpi );
+	auto& tmetrics = tface->mFace->size->metrics;
+	tface->mLineHeight = (float)tmetrics.height / 64.f;
+	tface->mAscender = (float)tmetrics.ascender / 64.f;
+	tface->mDescender = (float)tmetrics.descender / 64.f;
+	tface->mBHasKerning = FT_HAS_KERNING( tface->mFace );
+
+	mFaces[ tkey ] = tface;
+	return tface;
+}
+
+//--------------------------------------------------------------
+void FontMetrics::clear() {
+	std::lock_guard<std::mutex> lock( mMutex );
+	mFaces.clear();
+}
+
+//--------------------------------------------------------------
+std::size_t FontMetrics::getNumFaces() {
+	std::lock_guard<std::mutex> lock( mMutex );
+	std::size_t tnum = 0;
+	for( auto& it : mFaces ) {
+		if( it.second ) tnum++;
+	}
+	return tnum;
+}
@@ -0,0 +1,91 @@
+//
+//  ofxSvgFontMetrics.h
+//
+//  Glyph metrics read from the font files with FreeType, without loading an ofTrueTypeFont
+//  or creating textures, so text can be measured without a gl context.
+//
+
+#pragma once
+#include "ofRectangle.h"
+#include <unordered_map>
+#include <mutex>
+
+typedef struct FT_LibraryRec_* FT_Library;
+typedef struct FT_FaceRec_* FT_Face;
+
+namespace ofx::svg {
+class FontMetrics {
+public:
+	// in pixels, with y pointing down like ofTrueTypeFont
+	struct Glyph {
+		float advance = 0.f;
+		float bearingX = 0.f;
+		float bearingY = 0.f;
+		float width = 0.f;
+		float height = 0.f;
+		unsigned int index = 0;
+	};
+
+	// a font file loaded at one size, the glyph metrics are cached on first use
+	class Face {
+	public:
+		~Face();
+		bool isLoaded() { return mFace != nullptr; }
+		const std::string& getPath() { return mPath; }
+		int getFontSize() { return mFontSize; }
+
+		float getLineHeight() { return mLineHeight; }
+		float getAscender() { return mAscender; }
+		float getDescender() { return mDescender; }
+
+		Glyph getGlyph( uint32_t aCodepoint );
+		// same layout as ofTrueTypeFont::getStringBoundingBox, with kerning, tabs and new lines
+		ofRectangle getStringBoundingBox( const std::string& aUtf8String, float x, float y );
+		float getStringWidth( const std::string& aUtf8String );
+		// horizontal kerning between two glyph indices, 0 for fonts without kerning
+		float getKerning( unsigned int aLeftIndex, unsigned int aRightIndex );
+		// renders the 8 bit coverage of the glyph, aLeft and aTop are the offsets from the pen position to the
+		// top left of the bitmap, with y pointing up like FreeType. Returns false for glyphs without an image.
+		bool renderGlyph( uint32_t aCodepoint, std::vector<unsigned char>& aCoverage, int& aWidth, int& aHeight, int& aLeft, int& aTop );
+
+		std::size_t getNumCachedGlyphs();
+
+	protected:
+		friend class FontMetrics;
+		const Glyph& _getGlyph( uint32_t aCodepoint );
+		float _getKerning( unsigned int aLeftIndex, unsigned int aRightIndex );
+
+		std::mutex mMutex;
+		FT_Face mFace = nullptr;
+		std::string mPath;
+		int mFontSize = 0;
+		float mLineHeight = 0.f;
+		float mAscender = 0.f;
+		float mDescender = 0.f;
+		bool mBHasKerning = false;
+		std::unordered_map< uint32_t, Glyph > mGlyphs;
+	};
+
+	// metrics shared by all of the documents, like the fonts in Text
+	static FontMetrics& sGetShared();
+	~FontMetrics();
+
+	// returns the face for the font file and size, loading it on the first call.
+	// Returns nullptr if the file could not be loaded. Safe to call from several threads.
+	std::shared_ptr<Face> get( const std::string& aFontPath, int aFontSize, int aDpi = 72 );
+
+	// faces that are still referenced stay valid until they are released
+	void clear();
+	std::size_t getNumFaces();
+
+	// will log messages to this module name
+	static const std::string moduleName() { return "ofx::svg::FontMetrics"; }
+
+protected:
+	std::mutex mMutex;
+	FT_Library mLibrary = nullptr;
+	bool mBLibraryFailed = false;
+	// keyed by the path, size and dpi
+	std::unordered_map< std::string, std::shared_ptr<Face> > mFaces;
+};
+}
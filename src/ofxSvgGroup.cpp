@@ -5,6 +5,7 @@
 //
 
 #include "ofxSvgGroup.h"
+#include "ofxSvgMemoryStats.h"
 #include "ofGraphics.h"
 
 using namespace ofx::svg;
@@ -12,6 +13,16 @@ using std::vector;
 using std::shared_ptr;
 using std::string;
 
+//--------------------------------------------------------------
+Group::~Group() {
+	// children may outlive this group, so make sure they do not point back to it
+	for( auto& kid : mChildren ) {
+		if( kid && kid->mParent == this ) {
+			kid->mParent = nullptr;
+		}
+	}
+}
+
 //--------------------------------------------------------------
 void Group::draw() {
     std::size_t numElements = mChildren.size();
@@ -28,6 +39,288 @@ void Group::draw() {
     }
 }
 
+//--------------------------------------------------------------
+void Group::draw( const ofRectangle& aViewRect ) {
+	_syncChildren();
+	// the bounds are in document space, so account for the positions of the parents
+	glm::vec2 offset = pos;
+	Group* parent = mParent;
+	while( parent ) {
+		offset += parent->pos;
+		parent = parent->mParent;
+	}
+	if( mBBoundsDirty ) {
+		_updateBounds( offset );
+	}
+	mNumDrawnElements = 0;
+	mNumCulledElements = 0;
+	_drawCulledRecursive( aViewRect, mNumDrawnElements, mNumCulledElements );
+}
+
+//--------------------------------------------------------------
+void Group::drawCulled() {
+	draw( sGetCurrentViewRect() );
+}
+
+//--------------------------------------------------------------
+ofRectangle Group::sGetCurrentViewRect() {
+	glm::mat4 mvp = ofGetCurrentMatrix( OF_MATRIX_PROJECTION ) * ofGetCurrentMatrix( OF_MATRIX_MODELVIEW );
+	glm::mat4 invMvp = glm::inverse( mvp );
+	
+	ofRectangle viewRect;
+	const glm::vec2 ndcCorners[4] = { glm::vec2(-1.f, -1.f), glm::vec2(1.f, -1.f), glm::vec2(1.f, 1.f), glm::vec2(-1.f, 1.f) };
+	for( int i = 0; i < 4; i++ ) {
+		// unproject the corner on the near and far planes and intersect the ray with z = 0
+		glm::vec4 pnear = invMvp * glm::vec4( ndcCorners[i].x, ndcCorners[i].y, -1.f, 1.f );
+		glm::vec4 pfar = invMvp * glm::vec4( ndcCorners[i].x, ndcCorners[i].y, 1.f, 1.f );
+		glm::vec3 p0 = glm::vec3( pnear ) / pnear.w;
+		glm::vec3 p1 = glm::vec3( pfar ) / pfar.w;
+		glm::vec3 tpoint = p0;
+		float dz = p1.z - p0.z;
+		if( fabs(dz) > 0.000001f ) {
+			float t = ofClamp( -p0.z / dz, 0.f, 1.f );
+			tpoint = p0 + (p1 - p0) * t;
+		}
+		if( i == 0 ) {
+			viewRect.set( tpoint.x, tpoint.y, 0.f, 0.f );
+		} else {
+			viewRect.growToInclude( glm::vec2( tpoint.x, tpoint.y ));
+		}
+	}
+	return viewRect;
+}
+
+//--------------------------------------------------------------
+void Group::invalidateBounds() {
+	_invalidateBoundsRecursive();
+	// marks the parents
+	Element::invalidateBounds();
+}
+
+//--------------------------------------------------------------
+void Group::_drawCulledRecursive( const ofRectangle& aViewRect, std::size_t& aNumDrawn, std::size_t& aNumCulled ) {
+	std::size_t numElements = mChildren.size();
+	if( mChildBounds.size() != numElements ) {
+		// children were added or removed through a reference kept from getChildren() without
+		// markChildrenChanged(), so the bounds no longer line up with them, draw everything instead
+		draw();
+		forEach( [&aNumDrawn]( Element& aElement ) {
+			if( !aElement.isGroup() ) aNumDrawn++;
+		});
+		return;
+	}
+
+	bool bTrans = pos.x != 0 || pos.y != 0.0;
+	if( bTrans ) {
+		ofPushMatrix();
+		ofTranslate(pos.x, pos.y);
+	}
+	for( std::size_t i = 0; i < numElements; i++ ) {
+		auto& cbounds = mChildBounds[i];
+		if( !cbounds.bHasBounds || !aViewRect.intersects( cbounds.rect )) {
+			aNumCulled += cbounds.numElements;
+			continue;
+		}
+		if( mChildren[i]->isGroup() ) {
+			static_cast<Group*>( mChildren[i].get() )->_drawCulledRecursive( aViewRect, aNumDrawn, aNumCulled );
+		} else {
+			mChildren[i]->draw();
+			aNumDrawn++;
+		}
+	}
+	if( bTrans ) {
+		ofPopMatrix();
+	}
+}
+
+//--------------------------------------------------------------
+void Group::_updateBounds( const glm::vec2& aOffset ) {
+	mChildBounds.assign( mChildren.size(), ChildBounds() );
+	mBHasBounds = false;
+	mNumElementsBelow = 0;
+	for( std::size_t i = 0; i < mChildren.size(); i++ ) {
+		auto& kid = mChildren[i];
+		auto& cbounds = mChildBounds[i];
+		if( !kid ) continue;
+		if( kid->isGroup() ) {
+			auto kgroup = static_cast<Group*>( kid.get() );
+			if( kgroup->mBBoundsDirty ) {
+				kgroup->_updateBounds( aOffset + kgroup->pos );
+			}
+			cbounds.rect = kgroup->mBounds;
+			cbounds.bHasBounds = kgroup->mBHasBounds;
+			cbounds.numElements = kgroup->mNumElementsBelow;
+		} else {
+			// from the cached local bounds of the element
+			cbounds.bHasBounds = kid->hasBounds();
+			if( cbounds.bHasBounds ) {
+				cbounds.rect = kid->getLocalBounds();
+				cbounds.rect.x += aOffset.x;
+				cbounds.rect.y += aOffset.y;
+			}
+			cbounds.numElements = 1;
+		}
+		mNumElementsBelow += cbounds.numElements;
+		if( cbounds.bHasBounds ) {
+			if( mBHasBounds ) {
+				mBounds.growToInclude( cbounds.rect );
+			} else {
+				mBounds = cbounds.rect;
+				mBHasBounds = true;
+			}
+		}
+	}
+	mBBoundsDirty = false;
+}
+
+//--------------------------------------------------------------
+void Group::_invalidateBoundsRecursive() {
+	mBBoundsDirty = true;
+	mBLocalBoundsDirty = true;
+	for( auto& kid : mChildren ) {
+		if( !kid ) continue;
+		if( kid->isGroup() ) {
+			static_cast<Group*>( kid.get() )->_invalidateBoundsRecursive();
+		} else if( kid->getType() == TYPE_TEXT ) {
+			static_cast<Text*>( kid.get() )->invalidateBounds();
+		} else {
+			kid->mBLocalBoundsDirty = true;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+bool Group::_computeLocalBounds( ofRectangle& aBounds ) {
+	bool bHasBounds = false;
+	for( auto& kid : mChildren ) {
+		if( !kid || !kid->hasBounds() ) continue;
+		if( bHasBounds ) {
+			aBounds.growToInclude( kid->getLocalBounds() );
+		} else {
+			aBounds = kid->getLocalBounds();
+			bHasBounds = true;
+		}
+	}
+	if( bHasBounds ) {
+		aBounds.x += pos.x;
+		aBounds.y += pos.y;
+	}
+	return bHasBounds;
+}
+
+#pragma mark - TreeIterator
+//--------------------------------------------------------------
+Group::TreeIterator::TreeIterator( Group* aRoot, TraversalOrder aOrder, bool abSkipInvisible ) {
+	mRoot = aRoot;
+	mOrder = aOrder;
+	mBSkipInvisible = abSkipInvisible;
+	if( mRoot && mRoot->mChildren.size() ) {
+		_push( mRoot );
+		_settle();
+	}
+}
+
+//--------------------------------------------------------------
+Element* Group::TreeIterator::get() const {
+	if( mNumFrames == 0 ) {
+		return nullptr;
+	}
+	const Frame& frame = mNumFrames > sNumInlineFrames ? mOverflowFrames.back() : mFrames[mNumFrames-1];
+	return frame.group->mChildren[frame.index].get();
+}
+
+//--------------------------------------------------------------
+Group::TreeIterator& Group::TreeIterator::operator++() {
+	Element* current = get();
+	if( !current ) {
+		return *this;
+	}
+	bool bDescend = !mBSkipChildren && mOrder == TRAVERSE_DEPTH_FIRST && current->isGroup();
+	mBSkipChildren = false;
+	if( bDescend && static_cast<Group*>(current)->mChildren.size() ) {
+		_push( static_cast<Group*>(current) );
+	} else {
+		_top().index++;
+	}
+	_settle();
+	return *this;
+}
+
+//--------------------------------------------------------------
+Group::TreeIterator::Frame& Group::TreeIterator::_top() {
+	return mNumFrames > sNumInlineFrames ? mOverflowFrames.back() : mFrames[mNumFrames-1];
+}
+
+//--------------------------------------------------------------
+void Group::TreeIterator::_push( Group* aGroup ) {
+	Frame frame;
+	frame.group = aGroup;
+	frame.index = 0;
+	if( mNumFrames < sNumInlineFrames ) {
+		mFrames[mNumFrames] = frame;
+	} else {
+		mOverflowFrames.push_back( frame );
+	}
+	mNumFrames++;
+}
+
+//--------------------------------------------------------------
+void Group::TreeIterator::_pop() {
+	if( mNumFrames > sNumInlineFrames ) {
+		mOverflowFrames.pop_back();
+	}
+	mNumFrames--;
+}
+
+// moves forward until the current frame points at an element that should be returned
+//--------------------------------------------------------------
+void Group::TreeIterator::_settle() {
+	while( true ) {
+		if( mNumFrames == 0 ) {
+			if( mOrder == TRAVERSE_BREADTH_FIRST && mBHasDeeper ) {
+				// start over from the root, one level deeper
+				mTargetDepth++;
+				mBHasDeeper = false;
+				_push( mRoot );
+				continue;
+			}
+			return;
+		}
+		
+		Frame& frame = _top();
+		if( frame.index >= frame.group->mChildren.size() ) {
+			_pop();
+			if( mNumFrames > 0 ) {
+				_top().index++;
+			}
+			continue;
+		}
+		
+		Element* ele = frame.group->mChildren[frame.index].get();
+		if( !ele || (mBSkipInvisible && !ele->isVisible()) ) {
+			frame.index++;
+			continue;
+		}
+		
+		if( mOrder == TRAVERSE_BREADTH_FIRST ) {
+			bool bGroupWithKids = ele->isGroup() && static_cast<Group*>(ele)->mChildren.size();
+			if( getDepth() < mTargetDepth ) {
+				if( bGroupWithKids ) {
+					_push( static_cast<Group*>(ele) );
+				} else {
+					frame.index++;
+				}
+				continue;
+			}
+			if( bGroupWithKids ) {
+				mBHasDeeper = true;
+			}
+		}
+		return;
+	}
+}
+
+#pragma mark - Group
 //--------------------------------------------------------------
 std::size_t Group::getNumChildren() {
 	return mChildren.size();
@@ -35,9 +328,23 @@ std::size_t Group::getNumChildren() {
 
 //--------------------------------------------------------------
 vector< shared_ptr<Element> >& Group::getChildren() {
+	// the caller may change the children, so they are compared to the snapshot on the next lookup
+	// of this group or any of its parents
+	Group* tgroup = this;
+	while( tgroup ) {
+		tgroup->mBChildrenUnverified = true;
+		tgroup = tgroup->mParent;
+	}
     return mChildren;
 }
 
+//--------------------------------------------------------------
+void Group::markChildrenChanged() {
+	_updateChildrenSnapshot( false );
+	_linkChildrenRecursive();
+	_onChildrenChanged();
+}
+
 //--------------------------------------------------------------
 vector< shared_ptr<Element> > Group::getAllChildren() {
     vector< shared_ptr<Element> > retElements;
@@ -55,7 +362,7 @@ void Group::_getAllElementsRecursive( vector< shared_ptr<Element> >& aElesToRetu
     if( aele ) {
         if( aele->isGroup() ) {
             shared_ptr<Group> tgroup = std::dynamic_pointer_cast<Group>(aele);
-            for( auto ele : tgroup->getChildren() ) {
+            for( auto ele : tgroup->mChildren ) {
                 _getAllElementsRecursive( aElesToReturn, ele );
             }
         } else {
@@ -66,6 +373,20 @@ void Group::_getAllElementsRecursive( vector< shared_ptr<Element> >& aElesToRetu
 
 //--------------------------------------------------------------
 shared_ptr<Element> Group::getElementForName( std::string aPath, bool bStrict ) {
+	_syncChildren();
+	if( mBUseNameIndex ) {
+		if( mBNameIndexDirty ) {
+			buildNameIndex();
+		}
+		auto it = mNameIndex.find( aPath );
+		if( it != mNameIndex.end() ) {
+			return it->second;
+		}
+		// "*:name:other" only searches for name, so let the recursive search handle it
+		if( bStrict && aPath.rfind("*:", 0) != 0 ) {
+			return shared_ptr<Element>();
+		}
+	}
     
     vector< std::string > tsearches;
     if( ofIsStringInString( aPath, ":" ) ) {
@@ -82,20 +403,81 @@ shared_ptr<Element> Group::getElementForName( std::string aPath, bool bStrict )
 //--------------------------------------------------------------
 std::vector< std::shared_ptr<Element> > Group::getChildrenForName( const std::string& aname, bool bStrict ) {
 	std::vector< std::shared_ptr<Element> > relements;
-	for( auto& kid : mChildren ) {
-		if( bStrict ) {
+	if( bStrict ) {
+		for( auto& kid : mChildren ) {
 			if( kid->getName() == aname ) {
 				relements.push_back(kid);
 			}
-		} else {
-			if( ofIsStringInString( kid->getName(), aname )) {
-				relements.push_back(kid);
-			}
+		}
+	} else {
+		auto& tindex = _getChildrenNameSubstringIndex();
+		std::vector<std::size_t> tresults;
+		tindex.findContaining( aname, tresults );
+		relements.reserve( tresults.size() );
+		for( auto index : tresults ) {
+			relements.push_back( tindex.getElements()[index] );
+		}
+	}
+	return relements;
+}
+
+//--------------------------------------------------------------
+std::vector< std::shared_ptr<Element> > Group::getAllElementsContainingName( const std::string& aname ) {
+	std::vector< std::shared_ptr<Element> > relements;
+	auto& tindex = _getAllNameSubstringIndex();
+	std::vector<std::size_t> tresults;
+	tindex.findContaining( aname, tresults );
+	relements.reserve( tresults.size() );
+	for( auto index : tresults ) {
+		relements.push_back( tindex.getElements()[index] );
+	}
+	return relements;
+}
+
+//--------------------------------------------------------------
+std::vector< std::shared_ptr<Element> > Group::getAllElementsWithNamePrefix( const std::string& aprefix ) {
+	std::vector< std::shared_ptr<Element> > relements;
+	auto& tindex = _getAllNameSubstringIndex();
+	std::vector<std::size_t> tresults;
+	tindex.findWithPrefix( aprefix, tresults );
+	relements.reserve( tresults.size() );
+	for( auto index : tresults ) {
+		relements.push_back( tindex.getElements()[index] );
+	}
+	return relements;
+}
+
+//--------------------------------------------------------------
+std::vector< std::shared_ptr<Element> > Group::getChildrenForNameId( uint32_t aNameId ) {
+	std::vector< std::shared_ptr<Element> > relements;
+	for( auto& kid : mChildren ) {
+		if( kid && kid->nameId == aNameId ) {
+			relements.push_back(kid);
 		}
 	}
 	return relements;
 }
 
+//--------------------------------------------------------------
+std::vector< std::shared_ptr<Element> > Group::getAllElementsForNameId( uint32_t aNameId ) {
+	std::vector< std::shared_ptr<Element> > relements;
+	_getAllElementsForNameIdRecursive( aNameId, relements, mChildren );
+	return relements;
+}
+
+//--------------------------------------------------------------
+void Group::_getAllElementsForNameIdRecursive( uint32_t aNameId, vector< shared_ptr<Element> >& aElesToReturn, const vector< shared_ptr<Element> >& aElements ) {
+	for( auto& ele : aElements ) {
+		if( !ele ) continue;
+		if( ele->nameId == aNameId ) {
+			aElesToReturn.push_back( ele );
+		}
+		if( ele->isGroup() ) {
+			_getAllElementsForNameIdRecursive( aNameId, aElesToReturn, static_cast<Group*>( ele.get() )->mChildren );
+		}
+	}
+}
+
 //--------------------------------------------------------------
 void Group::_getElementForNameRecursive( vector<string>& aNamesToFind, shared_ptr<Element>& aTarget, vector< shared_ptr<Element> >& aElements, bool bStrict ) {
 	
@@ -154,7 +536,7 @@ void Group::_getElementForNameRecursive( vector<string>& aNamesToFind, shared_pt
 			} else {
 				if( aElements[i]->getType() == TYPE_GROUP ) {
 					auto tgroup = std::dynamic_pointer_cast<Group>( aElements[i] );
-					_getElementForNameRecursive( aNamesToFind, aTarget, tgroup->getChildren(), bStrict );
+					_getElementForNameRecursive( aNamesToFind, aTarget, tgroup->mChildren, bStrict );
 					break;
 				}
 			}
@@ -169,7 +551,7 @@ void Group::_getElementForNameRecursive( vector<string>& aNamesToFind, shared_pt
 				if( aElements[i]->getType() == TYPE_GROUP ) {
 //					std::cout << "Group::_getElementForNameRecursive: FOUND A GROUP, But still going: " << aElements[i]->getName() << " keep going: " << bKeepGoing << std::endl;
 					auto tgroup = std::dynamic_pointer_cast<Group>( aElements[i] );
-					_getElementForNameRecursive( aNamesToFind, aTarget, tgroup->getChildren(), bStrict );
+					_getElementForNameRecursive( aNamesToFind, aTarget, tgroup->mChildren, bStrict );
 				}
 			}
 		}
@@ -230,6 +612,22 @@ void Group::_getElementForNameRecursive( vector<string>& aNamesToFind, shared_pt
 bool Group::replace( shared_ptr<Element> aOriginal, shared_ptr<Element> aNew ) {
     bool bReplaced = false;
     _replaceElementRecursive( aOriginal, aNew, mChildren, bReplaced );
+	if( bReplaced ) {
+		_linkChildrenRecursive();
+		if( aOriginal && aOriginal->mParent ) {
+			bool bStillInTree = false;
+			for( auto& kid : aOriginal->mParent->mChildren ) {
+				if( kid == aOriginal ) {
+					bStillInTree = true;
+					break;
+				}
+			}
+			if( !bStillInTree ) {
+				aOriginal->mParent = nullptr;
+			}
+		}
+		_onChildrenChanged();
+	}
     return bReplaced;
 }
 
@@ -252,6 +650,148 @@ void Group::_replaceElementRecursive( shared_ptr<Element> aTarget, shared_ptr<El
     }
 }
 
+//--------------------------------------------------------------
+shared_ptr<Element> Group::hitTest( const glm::vec2& aPoint ) {
+	return getHitTester().hitTest( aPoint );
+}
+
+//--------------------------------------------------------------
+void Group::hitTest( const vector<glm::vec2>& aPoints, vector< shared_ptr<Element> >& aResults ) {
+	getHitTester().hitTest( aPoints, aResults );
+}
+
+//--------------------------------------------------------------
+vector< shared_ptr<Element> > Group::hitTestAll( const glm::vec2& aPoint ) {
+	return getHitTester().hitTestAll( aPoint );
+}
+
+//--------------------------------------------------------------
+HitTester& Group::getHitTester() {
+	_syncChildren();
+	if( mBHitTesterDirty ) {
+		mHitTester.build( *this );
+		mBHitTesterDirty = false;
+	}
+	return mHitTester;
+}
+
+//--------------------------------------------------------------
+void Group::invalidateHitTester() {
+	mHitTester.clear();
+	mBHitTesterDirty = true;
+}
+
+//--------------------------------------------------------------
+void Group::setNameIndexEnabled( bool ab ) {
+	mBUseNameIndex = ab;
+	if( !mBUseNameIndex ) {
+		mNameIndex.clear();
+		mBNameIndexDirty = true;
+	}
+}
+
+//--------------------------------------------------------------
+void Group::buildNameIndex() {
+	_syncChildren();
+	mNameIndex.clear();
+	_linkChildrenRecursive();
+	_addToNameIndexRecursive( "", true, mChildren );
+	mBNameIndexDirty = false;
+}
+
+//--------------------------------------------------------------
+void Group::invalidateNameIndex() {
+	mNameIndex.clear();
+	mBNameIndexDirty = true;
+	mChildrenNameSubstringIndex.clear();
+	mAllNameSubstringIndex.clear();
+}
+
+//--------------------------------------------------------------
+void Group::_addToNameIndexRecursive( const std::string& aPrefix, bool abAddPaths, vector< shared_ptr<Element> >& aElements ) {
+	for( auto& ele : aElements ) {
+		if( !ele ) continue;
+		// the path search only descends into the first child that matches the name at each level
+		bool bFirstForPath = false;
+		if( abAddPaths ) {
+			bFirstForPath = mNameIndex.emplace( aPrefix + ele->getName(), ele ).second;
+		}
+		// "*:name" is the first match in a depth first search
+		mNameIndex.emplace( "*:" + ele->getName(), ele );
+		if( ele->getType() == TYPE_GROUP ) {
+			auto tgroup = std::dynamic_pointer_cast<Group>( ele );
+			_addToNameIndexRecursive( aPrefix + ele->getName() + ":", bFirstForPath, tgroup->mChildren );
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void Group::_linkChildrenRecursive() {
+	for( auto& kid : mChildren ) {
+		if( !kid ) continue;
+		kid->mParent = this;
+		if( kid->getType() == TYPE_GROUP ) {
+			auto tgroup = std::dynamic_pointer_cast<Group>( kid );
+			tgroup->_linkChildrenRecursive();
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void Group::_onChildrenChanged() {
+	invalidateNameIndex();
+	invalidateHitTester();
+	mBTypeBucketsDirty = true;
+	mBBoundsDirty = true;
+	mBLocalBoundsDirty = true;
+	if( mParent ) {
+		mParent->_onChildrenChanged();
+	}
+}
+
+//--------------------------------------------------------------
+void Group::_syncChildren() {
+	if( !mBChildrenUnverified ) return;
+	mBChildrenUnverified = false;
+	bool bChanged = mChildrenSnapshot.size() != mChildren.size();
+	for( std::size_t i = 0; i < mChildren.size(); i++ ) {
+		auto& kid = mChildren[i];
+		if( !bChanged && mChildrenSnapshot[i] != kid.get() ) {
+			bChanged = true;
+		}
+		// groups below that were handed out on their own
+		if( kid && kid->isGroup() ) {
+			static_cast<Group*>( kid.get() )->_syncChildren();
+		}
+	}
+	if( bChanged ) {
+		_updateChildrenSnapshot( false );
+		_linkChildrenRecursive();
+		_onChildrenChanged();
+	}
+}
+
+//--------------------------------------------------------------
+void Group::_updateChildrenSnapshot( bool abRecursive ) {
+	mChildrenSnapshot.resize( mChildren.size() );
+	for( std::size_t i = 0; i < mChildren.size(); i++ ) {
+		mChildrenSnapshot[i] = mChildren[i].get();
+		if( abRecursive && mChildren[i] && mChildren[i]->isGroup() ) {
+			auto kgroup = static_cast<Group*>( mChildren[i].get() );
+			kgroup->mBChildrenUnverified = false;
+			kgroup->_updateChildrenSnapshot( true );
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void Group::addMemoryUsage( MemoryUsage& aUsage ) {
+	Element::addMemoryUsage( aUsage );
+	// the children are counted on their own
+	aUsage.elements += MemoryUsage::sGetNumBytes( mChildren );
+	aUsage.elements += MemoryUsage::sGetNumBytes( mChildrenSnapshot );
+}
+
 //--------------------------------------------------------------
 string Group::toString(int nlevel) {
     
@@ -273,24 +813,117 @@ string Group::toString(int nlevel) {
 
 //--------------------------------------------------------------
 void Group::disableColors() {
-    auto telements = getAllChildren();
-    for( auto& ele : telements ) {
-        ele->setUseShapeColor(false);
-    }
+	forEach( []( Element& ele ) {
+		if( !ele.isGroup() ) ele.setUseShapeColor(false);
+	});
 }
 
 //--------------------------------------------------------------
 void Group::enableColors() {
-    auto telements = getAllChildren();
-    for( auto& ele : telements ) {
-        ele->setUseShapeColor(true);
-    }
+	forEach( []( Element& ele ) {
+		if( !ele.isGroup() ) ele.setUseShapeColor(true);
+	});
 }
 
+//--------------------------------------------------------------
+const vector< shared_ptr<Element> >& Group::_getTypeBucket( SvgType aType ) {
+	_syncChildren();
+	if( mBTypeBucketsDirty ) {
+		_buildTypeBuckets();
+	}
+	return mTypeBuckets[ aType ];
+}
 
+//--------------------------------------------------------------
+const vector< shared_ptr<Element> >& Group::_getAllTypeBucket( SvgType aType ) {
+	_syncChildren();
+	if( mBTypeBucketsDirty ) {
+		_buildTypeBuckets();
+	}
+	return mAllTypeBuckets[ aType ];
+}
 
+//--------------------------------------------------------------
+const vector< shared_ptr<Element> >& Group::_getTypeBucketForPath( SvgType aType, const std::string& aPathToGroup, bool bStrict ) {
+	if( aPathToGroup != "" ) {
+		auto temp = getElementForName( aPathToGroup, bStrict );
+		if( temp && temp->isGroup() ) {
+			auto tgroup = std::static_pointer_cast<Group>( temp );
+			if( tgroup->mChildren.size() ) {
+				return tgroup->_getTypeBucket( aType );
+			}
+		}
+		if( mChildren.size() ) {
+			ofLogNotice("ofx::svg::Group") << __FUNCTION__ << " did not find group with name: " << aPathToGroup;
+		}
+	}
+	return _getTypeBucket( aType );
+}
 
+//--------------------------------------------------------------
+void Group::_buildTypeBuckets() {
+	for( auto& bucket : mTypeBuckets ) {
+		bucket.clear();
+	}
+	for( auto& bucket : mAllTypeBuckets ) {
+		bucket.clear();
+	}
+	for( auto& kid : mChildren ) {
+		if( kid && kid->getType() < TYPE_TOTAL ) {
+			mTypeBuckets[ kid->getType() ].push_back( kid );
+		}
+	}
+	_addToAllTypeBucketsRecursive( mChildren );
+	mBTypeBucketsDirty = false;
+}
 
+//--------------------------------------------------------------
+void Group::_addToAllTypeBucketsRecursive( vector< shared_ptr<Element> >& aElements ) {
+	for( auto& ele : aElements ) {
+		if( !ele ) continue;
+		if( ele->getType() < TYPE_TOTAL ) {
+			mAllTypeBuckets[ ele->getType() ].push_back( ele );
+		}
+		if( ele->isGroup() ) {
+			auto tgroup = std::static_pointer_cast<Group>( ele );
+			_addToAllTypeBucketsRecursive( tgroup->mChildren );
+		}
+	}
+}
 
+//--------------------------------------------------------------
+NameSubstringIndex& Group::_getChildrenNameSubstringIndex() {
+	_syncChildren();
+	if( !mChildrenNameSubstringIndex.isBuilt() ) {
+		std::vector< std::shared_ptr<Element> > telements;
+		telements.reserve( mChildren.size() );
+		for( auto& kid : mChildren ) {
+			if( kid ) telements.push_back( kid );
+		}
+		mChildrenNameSubstringIndex.build( telements );
+	}
+	return mChildrenNameSubstringIndex;
+}
 
+//--------------------------------------------------------------
+NameSubstringIndex& Group::_getAllNameSubstringIndex() {
+	_syncChildren();
+	if( !mAllNameSubstringIndex.isBuilt() ) {
+		std::vector< std::shared_ptr<Element> > telements;
+		_addAllElementsRecursive( telements, mChildren );
+		mAllNameSubstringIndex.build( telements );
+	}
+	return mAllNameSubstringIndex;
+}
 
+//--------------------------------------------------------------
+void Group::_addAllElementsRecursive( vector< shared_ptr<Element> >& aElesToReturn, vector< shared_ptr<Element> >& aElements ) {
+	for( auto& ele : aElements ) {
+		if( !ele ) continue;
+		aElesToReturn.push_back( ele );
+		if( ele->isGroup() ) {
+			auto tgroup = std::static_pointer_cast<Group>( ele );
+			_addAllElementsRecursive( aElesToReturn, tgroup->mChildren );
+		}
+	}
+}
@@ -6,114 +6,304 @@
 
 #pragma once
 #include "ofxSvgElements.h"
+#include "ofxSvgNameSubstringIndex.h"
+#include "ofxSvgHitTest.h"
+#include <unordered_map>
+#include <array>
+#include <type_traits>
+#include <typeinfo>
 
 namespace ofx::svg {
+
+// Non-owning view over the elements of a single type stored in a Group.
+// Iterating does not allocate or touch the reference counts.
+// Only valid until the children of the group that returned it change.
+// Elements are nullptr when they are not of the type, ie. Paths in the view of a
+// subclass of Path that does not override sGetType().
+template<typename ofxSvgType>
+class ElementView {
+public:
+	typedef std::vector< std::shared_ptr<Element> > Container;
+	
+	// the groups store the elements by sGetType(), which subclasses may share with their base class,
+	// so only casts statically when the element is exactly of the type. Returns nullptr if it is not one.
+	static ofxSvgType* sCast( Element* aElement ) {
+		if( !aElement ) return nullptr;
+		if( typeid( *aElement ) == typeid( ofxSvgType ) ) {
+			return static_cast<ofxSvgType*>( aElement );
+		}
+		return dynamic_cast<ofxSvgType*>( aElement );
+	}
+	static std::shared_ptr<ofxSvgType> sCastShared( const std::shared_ptr<Element>& aElement ) {
+		if( !aElement ) return std::shared_ptr<ofxSvgType>();
+		if( typeid( *aElement ) == typeid( ofxSvgType ) ) {
+			return std::static_pointer_cast<ofxSvgType>( aElement );
+		}
+		return std::dynamic_pointer_cast<ofxSvgType>( aElement );
+	}
+	
+	class iterator {
+	public:
+		iterator( Container::const_iterator aIt ) : mIt(aIt) {}
+		ofxSvgType* operator*() const { return sCast( mIt->get() ); }
+		ofxSvgType* operator->() const { return sCast( mIt->get() ); }
+		iterator& operator++() { ++mIt; return *this; }
+		bool operator==( const iterator& aOther ) const { return mIt == aOther.mIt; }
+		bool operator!=( const iterator& aOther ) const { return mIt != aOther.mIt; }
+	protected:
+		Container::const_iterator mIt;
+	};
+	
+	ElementView( const Container& aElements ) : mElements( &aElements ) {}
+	
+	std::size_t size() const { return mElements->size(); }
+	bool empty() const { return mElements->empty(); }
+	ofxSvgType* operator[]( std::size_t aIndex ) const { return sCast( (*mElements)[aIndex].get() ); }
+	// returns a shared pointer if ownership is needed
+	std::shared_ptr<ofxSvgType> getShared( std::size_t aIndex ) const { return sCastShared( (*mElements)[aIndex] ); }
+	
+	iterator begin() const { return iterator( mElements->cbegin() ); }
+	iterator end() const { return iterator( mElements->cend() ); }
+	
+protected:
+	const Container* mElements = nullptr;
+};
+
 class Group : public Element {
 public:
+	enum TraversalOrder {
+		TRAVERSE_DEPTH_FIRST = 0,
+		TRAVERSE_BREADTH_FIRST
+	};
+	
+	// Walks the hierarchy below a group without allocating or touching reference counts.
+	// Depth first visits groups before their children. Breadth first revisits the upper levels
+	// for each depth, so it is O(elements * depth), which is fine for typical svg nesting.
+	class TreeIterator {
+	public:
+		TreeIterator() {}
+		TreeIterator( Group* aRoot, TraversalOrder aOrder, bool abSkipInvisible );
+		
+		Element* get() const;
+		Element& operator*() const { return *get(); }
+		Element* operator->() const { return get(); }
+		TreeIterator& operator++();
+		bool operator==( const TreeIterator& aOther ) const { return get() == aOther.get(); }
+		bool operator!=( const TreeIterator& aOther ) const { return get() != aOther.get(); }
+		
+		// do not descend into the children of the current element, depth first only
+		void skipChildren() { mBSkipChildren = true; }
+		// 0 for the direct children of the root group
+		std::size_t getDepth() const { return mNumFrames > 0 ? mNumFrames-1 : 0; }
+		
+	protected:
+		struct Frame {
+			Group* group = nullptr;
+			std::size_t index = 0;
+		};
+		Frame& _top();
+		void _push( Group* aGroup );
+		void _pop();
+		void _settle();
+		
+		Group* mRoot = nullptr;
+		TraversalOrder mOrder = TRAVERSE_DEPTH_FIRST;
+		bool mBSkipInvisible = false;
+		bool mBSkipChildren = false;
+		// breadth first state
+		std::size_t mTargetDepth = 0;
+		bool mBHasDeeper = false;
+		// stack of groups being walked, only spills into the vector for very deep hierarchies
+		static const std::size_t sNumInlineFrames = 16;
+		std::array< Frame, sNumInlineFrames > mFrames;
+		std::vector< Frame > mOverflowFrames;
+		std::size_t mNumFrames = 0;
+	};
+	
+	class TreeRange {
+	public:
+		TreeRange( Group* aRoot, TraversalOrder aOrder, bool abSkipInvisible ) : mRoot(aRoot), mOrder(aOrder), mBSkipInvisible(abSkipInvisible) {}
+		TreeIterator begin() const { return TreeIterator( mRoot, mOrder, mBSkipInvisible ); }
+		TreeIterator end() const { return TreeIterator(); }
+	protected:
+		Group* mRoot = nullptr;
+		TraversalOrder mOrder = TRAVERSE_DEPTH_FIRST;
+		bool mBSkipInvisible = false;
+	};
 	
-	virtual SvgType getType() override {return TYPE_GROUP;}
+	virtual ~Group();
+	
+	static SvgType sGetType() {return TYPE_GROUP;}
+	virtual SvgType getType() override {return sGetType();}
 	
 	virtual void draw() override;
+	// only draws the elements whose document space bounds intersect the view rectangle,
+	// whole groups outside of it are skipped. The bounds are cached, call invalidateBounds() after moving elements.
+	void draw( const ofRectangle& aViewRect );
+	// culls against the area of the z = 0 plane that is visible with the current matrices
+	void drawCulled();
+	// document space area of the z = 0 plane visible with the current projection and modelview matrices
+	static ofRectangle sGetCurrentViewRect();
+	// counts of the non group elements from the last culled draw
+	std::size_t getNumDrawnElements() { return mNumDrawnElements; }
+	std::size_t getNumCulledElements() { return mNumCulledElements; }
+	// marks the cached bounds of this group and everything below it as dirty, propagates up through the parents
+	virtual void invalidateBounds() override;
 	
 	std::size_t getNumChildren();// override;
+	// children added, removed or reordered through the returned vector are detected on the next lookup or draw,
+	// which compares them to the children at the last lookup and invalidates the cached lookups if they differ.
+	// Call markChildrenChanged() when keeping the reference and changing the children after a lookup.
 	std::vector< std::shared_ptr<Element> >& getChildren();
+	const std::vector< std::shared_ptr<Element> >& getChildren() const { return mChildren; }
+	// sets the parents of the children and invalidates the cached lookups ( name index, type buckets, bounds )
+	// of this group and its parents, and the indices and renderers of the document.
+	void markChildrenChanged();
+	// flattened list of the elements below this group, excluding groups.
+	// Allocates, prefer forEach or traverseDepthFirst when walking the tree often.
 	std::vector< std::shared_ptr<Element> > getAllChildren();
 	
-	template<typename ofxSvgType>
-	std::vector< std::shared_ptr<ofxSvgType> > getElementsForType( std::string aPathToGroup="", bool bStrict= false ) {
-		std::shared_ptr<ofxSvgType> temp = std::make_shared<ofxSvgType>();
-		auto sType = temp->getType();
-		
-		std::vector< std::shared_ptr<ofxSvgType> > telements;
-		std::vector< std::shared_ptr<Element> > elementsToSearch;
-		if( aPathToGroup == "" ) {
-			elementsToSearch = mChildren;
-		} else {
-			std::shared_ptr< Element > temp = getElementForName( aPathToGroup, bStrict );
-			if( temp ) {
-				if( temp->isGroup() ) {
-					std::shared_ptr< Group > tgroup = std::dynamic_pointer_cast<Group>( temp );
-					elementsToSearch = tgroup->mChildren;
+	// for( auto& ele : svg.traverseDepthFirst() ) { ... }
+	TreeRange traverseDepthFirst( bool abSkipInvisible = false ) { return TreeRange( this, TRAVERSE_DEPTH_FIRST, abSkipInvisible ); }
+	TreeRange traverseBreadthFirst( bool abSkipInvisible = false ) { return TreeRange( this, TRAVERSE_BREADTH_FIRST, abSkipInvisible ); }
+	
+	// Calls aVisitor( Element& ) for every element below this group, including groups.
+	// The visitor can return false to stop early. aFilter( Element& ) is called first,
+	// return false from it to skip the element and all of its children, ie.
+	// svg.forEach( visitor, []( Element& e ){ return e.isVisible(); } );
+	// returns false if the visitor stopped the traversal.
+	template<typename Visitor, typename Filter>
+	bool forEach( Visitor&& aVisitor, Filter&& aFilter, TraversalOrder aOrder = TRAVERSE_DEPTH_FIRST ) {
+		if( aOrder == TRAVERSE_BREADTH_FIRST ) {
+			bool bHasDeeper = true;
+			for( std::size_t depth = 0; bHasDeeper; depth++ ) {
+				bHasDeeper = false;
+				if( !_forEachAtDepth( aVisitor, aFilter, depth, bHasDeeper )) {
+					return false;
 				}
 			}
+			return true;
 		}
-		
-		if( !elementsToSearch.size() && mChildren.size() ) {
-			ofLogNotice("ofx::svg::Group") << __FUNCTION__ << " did not find group with name: " << aPathToGroup;
-			elementsToSearch = mChildren;
-		}
-		
-		for( std::size_t i = 0; i < elementsToSearch.size(); i++ ) {
-			if( elementsToSearch[i]->getType() == sType ) {
-				telements.push_back( std::dynamic_pointer_cast< ofxSvgType>(elementsToSearch[i]) );
+		return _forEachDepthFirst( aVisitor, aFilter );
+	}
+	
+	template<typename Visitor>
+	bool forEach( Visitor&& aVisitor, TraversalOrder aOrder = TRAVERSE_DEPTH_FIRST ) {
+		return forEach( aVisitor, []( Element& ){ return true; }, aOrder );
+	}
+	
+	template<typename ofxSvgType>
+	std::vector< std::shared_ptr<ofxSvgType> > getElementsForType( std::string aPathToGroup="", bool bStrict= false ) {
+		std::vector< std::shared_ptr<ofxSvgType> > telements;
+		auto& elementsToSearch = _getTypeBucketForPath( ofxSvgType::sGetType(), aPathToGroup, bStrict );
+		telements.reserve( elementsToSearch.size() );
+		for( auto& ele : elementsToSearch ) {
+			if( auto tele = ElementView<ofxSvgType>::sCastShared( ele ) ) {
+				telements.push_back( tele );
 			}
 		}
 		return telements;
 	}
 	
+	// same as getElementsForType, but does not allocate or copy the shared pointers.
+	template<typename ofxSvgType>
+	ElementView<ofxSvgType> getElementsForTypeView( std::string aPathToGroup="", bool bStrict= false ) {
+		return ElementView<ofxSvgType>( _getTypeBucketForPath( ofxSvgType::sGetType(), aPathToGroup, bStrict ));
+	}
+	
 	template<typename ofxSvgType>
 	std::shared_ptr<ofxSvgType> getFirstElementForType( std::string aPathToGroup="", bool bStrict= false ) {
-		auto eles = getElementsForType<ofxSvgType>(aPathToGroup, bStrict );
-		if( eles.size() > 0 ) {
-			return eles[0];
+		auto& eles = _getTypeBucketForPath( ofxSvgType::sGetType(), aPathToGroup, bStrict );
+		for( auto& ele : eles ) {
+			if( auto tele = ElementView<ofxSvgType>::sCastShared( ele ) ) {
+				return tele;
+			}
 		}
 		return std::shared_ptr<ofxSvgType>();
 	}
 	
 	template<typename ofxSvgType>
 	std::vector< std::shared_ptr<ofxSvgType> > getAllElementsForType() {
-		
-		auto temp = std::make_shared<ofxSvgType>();
-		auto sType = temp->getType();
-		
 		std::vector< std::shared_ptr<ofxSvgType> > telements;
-		auto elementsToSearch = getAllChildren();
-		
-		for( std::size_t i = 0; i < elementsToSearch.size(); i++ ) {
-			if( elementsToSearch[i]->getType() == sType ) {
-				telements.push_back( std::dynamic_pointer_cast<ofxSvgType>(elementsToSearch[i]) );
+		auto& elementsToSearch = _getAllTypeBucket( ofxSvgType::sGetType() );
+		telements.reserve( elementsToSearch.size() );
+		for( auto& ele : elementsToSearch ) {
+			if( auto tele = ElementView<ofxSvgType>::sCastShared( ele ) ) {
+				telements.push_back( tele );
 			}
 		}
 		return telements;
 	}
 	
+	// all of the elements of a type in the hierarchy, does not allocate or copy the shared pointers.
+	template<typename ofxSvgType>
+	ElementView<ofxSvgType> getAllElementsForTypeView() {
+		return ElementView<ofxSvgType>( _getAllTypeBucket( ofxSvgType::sGetType() ));
+	}
+	
+	// uses an n-gram index over the names, built on the first query.
 	template<typename ofxSvgType>
 	std::vector< std::shared_ptr<ofxSvgType> > getAllElementsContainingNameForType(std::string aname) {
-		
-		auto temp = std::make_shared<ofxSvgType>();
-		auto sType = temp->getType();
-		
 		std::vector< std::shared_ptr<ofxSvgType> > telements;
-		auto elementsToSearch = getAllChildren();
-		
-		for( std::size_t i = 0; i < elementsToSearch.size(); i++ ) {
-			if( elementsToSearch[i]->getType() == sType ) {
-				if( ofIsStringInString(elementsToSearch[i]->getName(), aname) ) {
-					telements.push_back( std::dynamic_pointer_cast<ofxSvgType>(elementsToSearch[i]) );
-				}
-			}
-		}
+		auto& tindex = _getAllNameSubstringIndex();
+		std::vector<std::size_t> tresults;
+		tindex.findContaining( aname, tresults );
+		_addResultsForType<ofxSvgType>( tindex, tresults, telements );
 		return telements;
 	}
 	
+	template<typename ofxSvgType>
+	std::vector< std::shared_ptr<ofxSvgType> > getAllElementsWithNamePrefixForType( const std::string& aprefix ) {
+		std::vector< std::shared_ptr<ofxSvgType> > telements;
+		auto& tindex = _getAllNameSubstringIndex();
+		std::vector<std::size_t> tresults;
+		tindex.findWithPrefix( aprefix, tresults );
+		_addResultsForType<ofxSvgType>( tindex, tresults, telements );
+		return telements;
+	}
+	
+	// all of the elements in the hierarchy, including groups, whose names contain or start with the string
+	std::vector< std::shared_ptr<Element> > getAllElementsContainingName( const std::string& aname );
+	std::vector< std::shared_ptr<Element> > getAllElementsWithNamePrefix( const std::string& aprefix );
+	
+	// When the name index is enabled, exact names and full colon paths ( "a:b:c" and "*:c" ) are
+	// looked up in O(1). If there is no exact match and bStrict is false, falls back to the substring search.
 	std::shared_ptr<Element> getElementForName( std::string aPath, bool bStrict = false );	
 	std::vector< std::shared_ptr<Element> > getChildrenForName( const std::string& aname, bool bStrict = false );
 	
 	template<typename ofxSvgType>
 	std::vector< std::shared_ptr<ofxSvgType> > getChildrenForTypeForName( const std::string& aname, bool bStrict = false ) {
-		auto temp = std::make_shared<ofxSvgType>();
-		auto sType = temp->getType();
-		
 		std::vector< std::shared_ptr<ofxSvgType> > relements;
-		for( auto& kid : mChildren ) {
-			if( kid->getType() != sType ) {continue;}
-			if( bStrict ) {
+		if( bStrict ) {
+			for( auto& kid : _getTypeBucket( ofxSvgType::sGetType() ) ) {
 				if( kid->getName() == aname ) {
-					relements.push_back( std::dynamic_pointer_cast<ofxSvgType>(kid));
+					if( auto tkid = ElementView<ofxSvgType>::sCastShared( kid ) ) {
+						relements.push_back( tkid );
+					}
 				}
-			} else {
-				if( ofIsStringInString( kid->getName(), aname )) {
-					relements.push_back(std::dynamic_pointer_cast<ofxSvgType>(kid));
+			}
+		} else {
+			auto& tindex = _getChildrenNameSubstringIndex();
+			std::vector<std::size_t> tresults;
+			tindex.findContaining( aname, tresults );
+			_addResultsForType<ofxSvgType>( tindex, tresults, relements );
+		}
+		return relements;
+	}
+	
+	// exact name matches by the id of the name in the string table of the document, compares integers instead of strings.
+	// The id comes from Parser::getStringTable().find( aname ).
+	std::vector< std::shared_ptr<Element> > getChildrenForNameId( uint32_t aNameId );
+	// all of the elements in the hierarchy, including groups, with the name id
+	std::vector< std::shared_ptr<Element> > getAllElementsForNameId( uint32_t aNameId );
+	
+	template<typename ofxSvgType>
+	std::vector< std::shared_ptr<ofxSvgType> > getChildrenForTypeForNameId( uint32_t aNameId ) {
+		std::vector< std::shared_ptr<ofxSvgType> > relements;
+		for( auto& kid : _getTypeBucket( ofxSvgType::sGetType() ) ) {
+			if( kid->nameId == aNameId ) {
+				if( auto tkid = ElementView<ofxSvgType>::sCastShared( kid ) ) {
+					relements.push_back( tkid );
 				}
 			}
 		}
@@ -134,18 +324,162 @@ public:
 	
 	bool replace( std::shared_ptr<Element> aOriginal, std::shared_ptr<Element> aNew );
 	
+	// precise hit testing against the filled and stroked areas of the visible elements below this group,
+	// top most by layer. The points are in document space. The shapes are flattened on the first call,
+	// call invalidateHitTester() after moving elements.
+	std::shared_ptr<Element> hitTest( const glm::vec2& aPoint );
+	void hitTest( const std::vector<glm::vec2>& aPoints, std::vector< std::shared_ptr<Element> >& aResults );
+	std::vector< std::shared_ptr<Element> > hitTestAll( const glm::vec2& aPoint );
+	HitTester& getHitTester();
+	void invalidateHitTester();
+	
+	// name index, rebuilt lazily on the next lookup after the children have changed.
+	// Call invalidateNameIndex() if element names are changed directly, also clears the substring indices.
+	void setNameIndexEnabled( bool ab );
+	bool isNameIndexEnabled() { return mBUseNameIndex; }
+	void buildNameIndex();
+	void invalidateNameIndex();
+	
 	virtual std::string toString(int nlevel = 0) override;
+	virtual void addMemoryUsage( MemoryUsage& aUsage ) override;
 	
 	void disableColors();
 	void enableColors();
 	
 protected:
+	friend class Element;
 	void _getElementForNameRecursive( std::vector< std::string >& aNamesToFind, std::shared_ptr<Element>& aTarget, std::vector< std::shared_ptr<Element> >& aElements, bool bStrict );
 	void _getAllElementsRecursive( std::vector< std::shared_ptr<Element> >& aElesToReturn, std::shared_ptr<Element> aele );
+	void _getAllElementsForNameIdRecursive( uint32_t aNameId, std::vector< std::shared_ptr<Element> >& aElesToReturn, const std::vector< std::shared_ptr<Element> >& aElements );
+	
+	template<typename Visitor>
+	static bool _callVisitor( Visitor& aVisitor, Element& aEle ) {
+		if constexpr( std::is_void_v< decltype( aVisitor(aEle) ) > ) {
+			aVisitor( aEle );
+			return true;
+		} else {
+			return aVisitor( aEle );
+		}
+	}
+	
+	template<typename Visitor, typename Filter>
+	bool _forEachDepthFirst( Visitor& aVisitor, Filter& aFilter ) {
+		for( auto& kid : mChildren ) {
+			if( !kid || !aFilter( *kid ) ) continue;
+			if( !_callVisitor( aVisitor, *kid )) {
+				return false;
+			}
+			if( kid->isGroup() ) {
+				if( !static_cast<Group*>( kid.get() )->_forEachDepthFirst( aVisitor, aFilter )) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+	
+	template<typename Visitor, typename Filter>
+	bool _forEachAtDepth( Visitor& aVisitor, Filter& aFilter, std::size_t aDepth, bool& abHasDeeper ) {
+		for( auto& kid : mChildren ) {
+			if( !kid || !aFilter( *kid ) ) continue;
+			Group* kidGroup = kid->isGroup() ? static_cast<Group*>( kid.get() ) : nullptr;
+			if( aDepth == 0 ) {
+				if( !_callVisitor( aVisitor, *kid )) {
+					return false;
+				}
+				if( kidGroup && kidGroup->mChildren.size() ) {
+					abHasDeeper = true;
+				}
+			} else if( kidGroup ) {
+				if( !kidGroup->_forEachAtDepth( aVisitor, aFilter, aDepth-1, abHasDeeper )) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
 	
 	void _replaceElementRecursive( std::shared_ptr<Element> aTarget, std::shared_ptr<Element> aNew, std::vector< std::shared_ptr<Element> >& aElements, bool& aBSuccessful );
 	
+	// sets the parent of all of the elements in the hierarchy below this group
+	void _linkChildrenRecursive();
+	// called when the children of this group change, propagates up through the parents
+	virtual void _onChildrenChanged();
+	// checks the groups handed out by getChildren() since the last check against their snapshots
+	// and calls _onChildrenChanged() for the ones that changed. Called before using the cached lookups.
+	void _syncChildren();
+	// takes the current children as the snapshot to compare to, below this group as well with abRecursive
+	void _updateChildrenSnapshot( bool abRecursive );
+	void _addToNameIndexRecursive( const std::string& aPrefix, bool abAddPaths, std::vector< std::shared_ptr<Element> >& aElements );
+	
+	void _drawCulledRecursive( const ofRectangle& aViewRect, std::size_t& aNumDrawn, std::size_t& aNumCulled );
+	// computes the document space bounds of the children, aOffset is the accumulated position of this group and its parents
+	void _updateBounds( const glm::vec2& aOffset );
+	void _invalidateBoundsRecursive();
+	// union of the local bounds of the children, moved by the position of the group
+	virtual bool _computeLocalBounds( ofRectangle& aBounds ) override;
+	
+	// type buckets, rebuilt lazily after the children have changed
+	const std::vector< std::shared_ptr<Element> >& _getTypeBucket( SvgType aType );
+	const std::vector< std::shared_ptr<Element> >& _getAllTypeBucket( SvgType aType );
+	const std::vector< std::shared_ptr<Element> >& _getTypeBucketForPath( SvgType aType, const std::string& aPathToGroup, bool bStrict );
+	void _buildTypeBuckets();
+	void _addToAllTypeBucketsRecursive( std::vector< std::shared_ptr<Element> >& aElements );
+	
+	// substring indices, built lazily on the first query after the names or children have changed
+	NameSubstringIndex& _getChildrenNameSubstringIndex();
+	NameSubstringIndex& _getAllNameSubstringIndex();
+	void _addAllElementsRecursive( std::vector< std::shared_ptr<Element> >& aElesToReturn, std::vector< std::shared_ptr<Element> >& aElements );
+	
+	template<typename ofxSvgType>
+	void _addResultsForType( NameSubstringIndex& aIndex, const std::vector<std::size_t>& aResults, std::vector< std::shared_ptr<ofxSvgType> >& aElesToReturn ) {
+		auto& telements = aIndex.getElements();
+		for( auto index : aResults ) {
+			if( telements[index]->getType() == ofxSvgType::sGetType() ) {
+				if( auto tele = ElementView<ofxSvgType>::sCastShared( telements[index] ) ) {
+					aElesToReturn.push_back( tele );
+				}
+			}
+		}
+	}
+	
 	std::vector< std::shared_ptr<Element> > mChildren;
+	// set on this group and its parents by the non const getChildren(), cleared by _syncChildren()
+	bool mBChildrenUnverified = false;
+	// the children at the last check, compared by identity to detect changes made through getChildren()
+	std::vector< const Element* > mChildrenSnapshot;
+	
+	bool mBUseNameIndex = false;
+	bool mBNameIndexDirty = true;
+	// full colon paths and "*:name" keys mapped to the first matching element
+	std::unordered_map< std::string, std::shared_ptr<Element> > mNameIndex;
+	
+	bool mBTypeBucketsDirty = true;
+	// direct children of this group by type
+	std::array< std::vector< std::shared_ptr<Element> >, TYPE_TOTAL > mTypeBuckets;
+	// all of the elements in the hierarchy below this group by type
+	std::array< std::vector< std::shared_ptr<Element> >, TYPE_TOTAL > mAllTypeBuckets;
+	
+	// cached document space bounds of the children, aligned with mChildren
+	struct ChildBounds {
+		ofRectangle rect;
+		bool bHasBounds = false;
+		// number of non group elements, for counting culled groups
+		std::size_t numElements = 0;
+	};
+	bool mBBoundsDirty = true;
+	std::vector<ChildBounds> mChildBounds;
+	ofRectangle mBounds;
+	bool mBHasBounds = false;
+	std::size_t mNumElementsBelow = 0;
+	std::size_t mNumDrawnElements = 0;
+	std::size_t mNumCulledElements = 0;
+	
+	NameSubstringIndex mChildrenNameSubstringIndex;
+	NameSubstringIndex mAllNameSubstringIndex;
+	
+	bool mBHitTesterDirty = true;
+	HitTester mHitTester;
 };
 }
 
@@ -0,0 +1,367 @@
+//
+//  ofxSvgHitTest.cpp
+//
+
+#include "ofxSvgHitTest.h"
+#include "ofxSvgGroup.h"
+#include <algorithm>
+#include <limits>
+
+using namespace ofx::svg;
+using std::vector;
+using std::shared_ptr;
+
+//--------------------------------------------------------------
+void HitTester::build( Group& aRoot ) {
+	clear();
+	// document space, the root may be a group inside of the document
+	glm::vec2 toffset = aRoot.pos;
+	for( Group* parent = aRoot.getParent(); parent; parent = parent->getParent() ) {
+		toffset += parent->pos;
+	}
+	_collectRecursive( aRoot, toffset );
+	for( std::size_t i = 0; i < mShapes.size(); i++ ) {
+		mShapeForElement[ mShapes[i].element.get() ] = i;
+	}
+	_buildGrid();
+}
+
+//--------------------------------------------------------------
+void HitTester::clear() {
+	mShapes.clear();
+	mShapeForElement.clear();
+	mCellStarts.clear();
+	mCellShapes.clear();
+	mGridCols = mGridRows = 0;
+}
+
+//--------------------------------------------------------------
+shared_ptr<Element> HitTester::hitTest( const glm::vec2& aPoint ) {
+	if( mGridCols < 1 ) return shared_ptr<Element>();
+
+	std::size_t cell = _getCell( aPoint );
+	if( cell >= mGridCols * mGridRows ) {
+		return shared_ptr<Element>();
+	}
+
+	const Shape* best = nullptr;
+	for( std::size_t i = mCellStarts[cell]; i < mCellStarts[cell+1]; i++ ) {
+		const Shape& shape = mShapes[ mCellShapes[i] ];
+		// no need for the precise test if it would be underneath anyway
+		if( best && !_isAbove( shape, *best )) continue;
+		if( _isInside( shape, aPoint )) {
+			best = &shape;
+		}
+	}
+	if( best ) {
+		return best->element;
+	}
+	return shared_ptr<Element>();
+}
+
+//--------------------------------------------------------------
+void HitTester::hitTest( const vector<glm::vec2>& aPoints, vector< shared_ptr<Element> >& aResults ) {
+	aResults.resize( aPoints.size() );
+	for( std::size_t i = 0; i < aPoints.size(); i++ ) {
+		aResults[i] = hitTest( aPoints[i] );
+	}
+}
+
+//--------------------------------------------------------------
+vector< shared_ptr<Element> > HitTester::hitTestAll( const glm::vec2& aPoint ) {
+	vector< shared_ptr<Element> > relements;
+	if( mGridCols < 1 ) return relements;
+
+	std::size_t cell = _getCell( aPoint );
+	if( cell >= mGridCols * mGridRows ) {
+		return relements;
+	}
+
+	vector<const Shape*> hits;
+	for( std::size_t i = mCellStarts[cell]; i < mCellStarts[cell+1]; i++ ) {
+		const Shape& shape = mShapes[ mCellShapes[i] ];
+		if( _isInside( shape, aPoint )) {
+			hits.push_back( &shape );
+		}
+	}
+	std::sort( hits.begin(), hits.end(), [this]( const Shape* a, const Shape* b ) {
+		return _isAbove( *a, *b );
+	});
+	relements.reserve( hits.size() );
+	for( auto hit : hits ) {
+		relements.push_back( hit->element );
+	}
+	return relements;
+}
+
+//--------------------------------------------------------------
+bool HitTester::isInside( const shared_ptr<Element>& aElement, const glm::vec2& aPoint ) {
+	if( !aElement ) return false;
+	auto it = mShapeForElement.find( aElement.get() );
+	if( it == mShapeForElement.end() ) {
+		return false;
+	}
+	return _isInside( mShapes[it->second], aPoint );
+}
+
+//--------------------------------------------------------------
+void HitTester::_collectRecursive( Group& aGroup, const glm::vec2& aOffset ) {
+	const Group& cgroup = aGroup;
+	for( auto& kid : cgroup.getChildren() ) {
+		if( !kid || !kid->isVisible() ) continue;
+		if( kid->isGroup() ) {
+			auto& kgroup = static_cast<Group&>( *kid );
+			_collectRecursive( kgroup, aOffset + kgroup.pos );
+		} else {
+			_addShape( kid, aOffset );
+		}
+	}
+}
+
+//--------------------------------------------------------------
+bool HitTester::_addShape( const shared_ptr<Element>& aElement, const glm::vec2& aOffset ) {
+	Shape shape;
+	shape.element = aElement;
+	shape.layer = aElement->layer;
+	shape.order = mShapes.size();
+
+	glm::vec2 tmin( std::numeric_limits<float>::max() );
+	glm::vec2 tmax( -std::numeric_limits<float>::max() );
+	auto addPoint = [&tmin, &tmax]( const glm::vec2& ap ) {
+		tmin.x = std::min( tmin.x, ap.x );
+		tmin.y = std::min( tmin.y, ap.y );
+		tmax.x = std::max( tmax.x, ap.x );
+		tmax.y = std::max( tmax.y, ap.y );
+	};
+
+	auto etype = aElement->getType();
+	if( etype == TYPE_TEXT || etype == TYPE_IMAGE ) {
+		shape.bRectangle = true;
+		glm::mat4 transform = glm::translate( glm::mat4(1.f), glm::vec3( aOffset.x, aOffset.y, 0.f ));
+		if( etype == TYPE_TEXT ) {
+			auto& etext = static_cast<Text&>( *aElement );
+			if( etext.textSpans.empty() ) return false;
+			shape.localRect = etext.getRectangle();
+		} else {
+			auto& eimage = static_cast<Image&>( *aElement );
+			shape.localRect.set( 0.f, 0.f, eimage.width, eimage.height );
+			transform = transform * eimage.getTransformMatrix();
+		}
+		shape.invTransform = glm::inverse( transform );
+		addPoint( transform * glm::vec4( shape.localRect.getTopLeft(), 1.f ));
+		addPoint( transform * glm::vec4( shape.localRect.getTopRight(), 1.f ));
+		addPoint( transform * glm::vec4( shape.localRect.getBottomRight(), 1.f ));
+		addPoint( transform * glm::vec4( shape.localRect.getBottomLeft(), 1.f ));
+	} else if( etype == TYPE_PATH || etype == TYPE_RECTANGLE || etype == TYPE_CIRCLE || etype == TYPE_ELLIPSE ) {
+		auto& epath = static_cast<Path&>( *aElement );
+		shape.bFilled = epath.isFilled();
+		if( epath.hasStroke() ) {
+			shape.halfStrokeWidth = epath.getStrokeWidth() * 0.5f;
+		}
+		if( !shape.bFilled && shape.halfStrokeWidth <= 0.f ) {
+			return false;
+		}
+		shape.windingMode = epath.path.getWindingMode();
+
+		for( auto& outline : epath.path.getOutline() ) {
+			auto& verts = outline.getVertices();
+			if( verts.size() < 2 ) continue;
+			for( std::size_t i = 0; i < verts.size(); i++ ) {
+				glm::vec2 p0( verts[i].x + aOffset.x, verts[i].y + aOffset.y );
+				addPoint( p0 );
+				std::size_t ni = i + 1;
+				bool bStroked = true;
+				if( ni == verts.size() ) {
+					// svg fills open subpaths as if they were closed
+					ni = 0;
+					bStroked = outline.isClosed();
+				}
+				Edge edge;
+				edge.p0 = p0;
+				edge.p1 = glm::vec2( verts[ni].x + aOffset.x, verts[ni].y + aOffset.y );
+				edge.bStroked = bStroked;
+				if( edge.p0 == edge.p1 ) continue;
+				shape.edges.push_back( edge );
+			}
+		}
+		if( shape.edges.empty() ) {
+			return false;
+		}
+		tmin -= glm::vec2( shape.halfStrokeWidth, shape.halfStrokeWidth );
+		tmax += glm::vec2( shape.halfStrokeWidth, shape.halfStrokeWidth );
+	} else {
+		return false;
+	}
+
+	shape.min = tmin;
+	shape.max = tmax;
+	if( !shape.bRectangle ) {
+		_buildRows( shape );
+	}
+	mShapes.push_back( std::move(shape) );
+	return true;
+}
+
+//--------------------------------------------------------------
+void HitTester::_buildRows( Shape& aShape ) {
+	aShape.numRows = std::max( (std::size_t)1, std::min( aShape.edges.size() / 4, (std::size_t)64 ));
+	float height = aShape.max.y - aShape.min.y;
+	aShape.rowHeight = height > 0.f ? height / (float)aShape.numRows : 1.f;
+
+	auto rowRange = [&aShape]( const Edge& aEdge, std::size_t& ar0, std::size_t& ar1 ) {
+		float y0 = std::min( aEdge.p0.y, aEdge.p1.y ) - aShape.halfStrokeWidth;
+		float y1 = std::max( aEdge.p0.y, aEdge.p1.y ) + aShape.halfStrokeWidth;
+		float maxRow = (float)(aShape.numRows-1);
+		ar0 = (std::size_t)ofClamp( floorf( (y0 - aShape.min.y) / aShape.rowHeight ), 0.f, maxRow );
+		ar1 = (std::size_t)ofClamp( floorf( (y1 - aShape.min.y) / aShape.rowHeight ), 0.f, maxRow );
+	};
+
+	// count the edges per row, then fill in
+	aShape.rowStarts.assign( aShape.numRows + 1, 0 );
+	std::size_t r0, r1;
+	for( auto& edge : aShape.edges ) {
+		rowRange( edge, r0, r1 );
+		for( std::size_t r = r0; r <= r1; r++ ) {
+			aShape.rowStarts[r+1]++;
+		}
+	}
+	for( std::size_t r = 0; r < aShape.numRows; r++ ) {
+		aShape.rowStarts[r+1] += aShape.rowStarts[r];
+	}
+	aShape.rowEdges.resize( aShape.rowStarts.back() );
+	vector<std::size_t> fill( aShape.rowStarts.begin(), aShape.rowStarts.end()-1 );
+	for( std::size_t i = 0; i < aShape.edges.size(); i++ ) {
+		rowRange( aShape.edges[i], r0, r1 );
+		for( std::size_t r = r0; r <= r1; r++ ) {
+			aShape.rowEdges[ fill[r]++ ] = i;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void HitTester::_buildGrid() {
+	mCellStarts.clear();
+	mCellShapes.clear();
+	mGridCols = mGridRows = 0;
+	if( mShapes.empty() ) return;
+
+	mGridMin = glm::vec2( std::numeric_limits<float>::max() );
+	mGridMax = glm::vec2( -std::numeric_limits<float>::max() );
+	for( auto& shape : mShapes ) {
+		mGridMin.x = std::min( mGridMin.x, shape.min.x );
+		mGridMin.y = std::min( mGridMin.y, shape.min.y );
+		mGridMax.x = std::max( mGridMax.x, shape.max.x );
+		mGridMax.y = std::max( mGridMax.y, shape.max.y );
+	}
+
+	std::size_t numCells = (std::size_t)ceilf( sqrtf( (float)mShapes.size() ));
+	mGridCols = mGridRows = std::max( (std::size_t)1, std::min( numCells, (std::size_t)256 ));
+	mCellSize.x = std::max( (mGridMax.x - mGridMin.x) / (float)mGridCols, 1.f );
+	mCellSize.y = std::max( (mGridMax.y - mGridMin.y) / (float)mGridRows, 1.f );
+
+	auto cellRange = [this]( const Shape& ashape, std::size_t& ac0, std::size_t& ac1, std::size_t& ar0, std::size_t& ar1 ) {
+		ac0 = (std::size_t)ofClamp( floorf( (ashape.min.x - mGridMin.x) / mCellSize.x ), 0.f, (float)(mGridCols-1) );
+		ac1 = (std::size_t)ofClamp( floorf( (ashape.max.x - mGridMin.x) / mCellSize.x ), 0.f, (float)(mGridCols-1) );
+		ar0 = (std::size_t)ofClamp( floorf( (ashape.min.y - mGridMin.y) / mCellSize.y ), 0.f, (float)(mGridRows-1) );
+		ar1 = (std::size_t)ofClamp( floorf( (ashape.max.y - mGridMin.y) / mCellSize.y ), 0.f, (float)(mGridRows-1) );
+	};
+
+	mCellStarts.assign( mGridCols * mGridRows + 1, 0 );
+	std::size_t c0, c1, r0, r1;
+	for( auto& shape : mShapes ) {
+		cellRange( shape, c0, c1, r0, r1 );
+		for( std::size_t r = r0; r <= r1; r++ ) {
+			for( std::size_t c = c0; c <= c1; c++ ) {
+				mCellStarts[ r * mGridCols + c + 1 ]++;
+			}
+		}
+	}
+	for( std::size_t i = 0; i < mGridCols * mGridRows; i++ ) {
+		mCellStarts[i+1] += mCellStarts[i];
+	}
+	mCellShapes.resize( mCellStarts.back() );
+	vector<std::size_t> fill( mCellStarts.begin(), mCellStarts.end()-1 );
+	for( std::size_t i = 0; i < mShapes.size(); i++ ) {
+		cellRange( mShapes[i], c0, c1, r0, r1 );
+		for( std::size_t r = r0; r <= r1; r++ ) {
+			for( std::size_t c = c0; c <= c1; c++ ) {
+				mCellShapes[ fill[ r * mGridCols + c ]++ ] = i;
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------
+std::size_t HitTester::_getCell( const glm::vec2& aPoint ) const {
+	if( aPoint.x < mGridMin.x || aPoint.y < mGridMin.y || aPoint.x > mGridMax.x || aPoint.y > mGridMax.y ) {
+		return std::numeric_limits<std::size_t>::max();
+	}
+	std::size_t col = std::min( (std::size_t)( (aPoint.x - mGridMin.x) / mCellSize.x ), mGridCols-1 );
+	std::size_t row = std::min( (std::size_t)( (aPoint.y - mGridMin.y) / mCellSize.y ), mGridRows-1 );
+	return row * mGridCols + col;
+}
+
+//--------------------------------------------------------------
+bool HitTester::_isInside( const Shape& aShape, const glm::vec2& aPoint ) const {
+	if( aPoint.x < aShape.min.x || aPoint.y < aShape.min.y || aPoint.x > aShape.max.x || aPoint.y > aShape.max.y ) {
+		return false;
+	}
+
+	if( aShape.bRectangle ) {
+		glm::vec3 lp = aShape.invTransform * glm::vec4( aPoint.x, aPoint.y, 0.f, 1.f );
+		const ofRectangle& lrect = aShape.localRect;
+		return lp.x >= lrect.getMinX() && lp.x <= lrect.getMaxX() && lp.y >= lrect.getMinY() && lp.y <= lrect.getMaxY();
+	}
+
+	std::size_t row = (std::size_t)ofClamp( floorf( (aPoint.y - aShape.min.y) / aShape.rowHeight ), 0.f, (float)(aShape.numRows-1) );
+	float hw2 = aShape.halfStrokeWidth * aShape.halfStrokeWidth;
+	int winding = 0;
+	for( std::size_t i = aShape.rowStarts[row]; i < aShape.rowStarts[row+1]; i++ ) {
+		const Edge& edge = aShape.edges[ aShape.rowEdges[i] ];
+		if( aShape.bFilled ) {
+			// count the crossings of a ray going to the right of the point
+			if( (edge.p0.y <= aPoint.y) != (edge.p1.y <= aPoint.y) ) {
+				float t = (aPoint.y - edge.p0.y) / (edge.p1.y - edge.p0.y);
+				float x = edge.p0.x + t * (edge.p1.x - edge.p0.x);
+				if( x > aPoint.x ) {
+					winding += edge.p1.y > edge.p0.y ? 1 : -1;
+				}
+			}
+		}
+		if( hw2 > 0.f && edge.bStroked ) {
+			glm::vec2 dir = edge.p1 - edge.p0;
+			float t = glm::clamp( glm::dot( aPoint - edge.p0, dir ) / glm::dot( dir, dir ), 0.f, 1.f );
+			glm::vec2 diff = aPoint - (edge.p0 + dir * t);
+			if( glm::dot( diff, diff ) <= hw2 ) {
+				return true;
+			}
+		}
+	}
+
+	if( !aShape.bFilled ) {
+		return false;
+	}
+	switch( aShape.windingMode ) {
+		case OF_POLY_WINDING_ODD:
+			return (winding & 1) != 0;
+		case OF_POLY_WINDING_NONZERO:
+			return winding != 0;
+		case OF_POLY_WINDING_POSITIVE:
+			return winding > 0;
+		case OF_POLY_WINDING_NEGATIVE:
+			return winding < 0;
+		case OF_POLY_WINDING_ABS_GEQ_TWO:
+			return std::abs(winding) >= 2;
+		default:
+			break;
+	}
+	return (winding & 1) != 0;
+}
+
+//--------------------------------------------------------------
+bool HitTester::_isAbove( const Shape& a, const Shape& b ) const {
+	if( a.layer != b.layer ) {
+		return a.layer > b.layer;
+	}
+	return a.order > b.order;
+}
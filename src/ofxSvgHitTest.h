@@ -0,0 +1,87 @@
+//
+//  ofxSvgHitTest.h
+//
+//  Point in shape testing against the filled and stroked areas of the elements,
+//  respecting the fill rule of each path. Edges are flattened once into per shape
+//  tables bucketed by rows, and shapes are bucketed into a uniform grid, so batches
+//  of points can be tested every frame.
+//
+
+#pragma once
+#include "ofxSvgElements.h"
+#include <unordered_map>
+
+namespace ofx::svg {
+class Group;
+
+class HitTester {
+public:
+	// flattens the visible elements below aRoot, which can be the document or any group in it.
+	// Call again after elements change.
+	void build( Group& aRoot );
+	void clear();
+
+	bool isEmpty() { return mShapes.empty(); }
+	std::size_t getNumShapes() { return mShapes.size(); }
+
+	// the top most element ( highest layer ) under the point, nullptr if none
+	std::shared_ptr<Element> hitTest( const glm::vec2& aPoint );
+	// results are aligned with the points, with nullptr for points that do not hit anything
+	void hitTest( const std::vector<glm::vec2>& aPoints, std::vector< std::shared_ptr<Element> >& aResults );
+	// all of the elements under the point, sorted top most first
+	std::vector< std::shared_ptr<Element> > hitTestAll( const glm::vec2& aPoint );
+
+	// test a single element, the point is in document space
+	bool isInside( const std::shared_ptr<Element>& aElement, const glm::vec2& aPoint );
+
+protected:
+	struct Edge {
+		glm::vec2 p0, p1;
+		// false for the implicit closing edge of an open subpath, which is filled but not stroked
+		bool bStroked = true;
+	};
+
+	struct Shape {
+		std::shared_ptr<Element> element;
+		float layer = 0.f;
+		// order in the hierarchy, used to break ties between layers
+		std::size_t order = 0;
+		glm::vec2 min, max;
+
+		bool bFilled = false;
+		ofPolyWindingMode windingMode = OF_POLY_WINDING_ODD;
+		float halfStrokeWidth = 0.f;
+
+		// rectangle shapes ( images and text ) are tested with the inverse transform instead of edges
+		bool bRectangle = false;
+		glm::mat4 invTransform;
+		ofRectangle localRect;
+
+		std::vector<Edge> edges;
+		// edge indices bucketed by rows of the bounds, rowStarts has numRows+1 entries
+		std::size_t numRows = 0;
+		float rowHeight = 1.f;
+		std::vector<std::size_t> rowStarts;
+		std::vector<std::size_t> rowEdges;
+	};
+
+	void _collectRecursive( Group& aGroup, const glm::vec2& aOffset );
+	bool _addShape( const std::shared_ptr<Element>& aElement, const glm::vec2& aOffset );
+	void _buildRows( Shape& aShape );
+	void _buildGrid();
+	bool _isInside( const Shape& aShape, const glm::vec2& aPoint ) const;
+	bool _isAbove( const Shape& a, const Shape& b ) const;
+	std::size_t _getCell( const glm::vec2& aPoint ) const;
+
+	std::vector<Shape> mShapes;
+	std::unordered_map< Element*, std::size_t > mShapeForElement;
+
+	// uniform grid over all of the shapes
+	glm::vec2 mGridMin, mGridMax;
+	glm::vec2 mCellSize;
+	std::size_t mGridCols = 0;
+	std::size_t mGridRows = 0;
+	std::vector<std::size_t> mCellStarts;
+	std::vector<std::size_t> mCellShapes;
+};
+}
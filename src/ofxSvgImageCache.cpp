@@ -0,0 +1,221 @@
+//
+//  ofxSvgImageCache.cpp
+//
+
+#include "ofxSvgImageCache.h"
+#include "ofImage.h"
+#include "ofLog.h"
+
+using namespace ofx::svg;
+using std::shared_ptr;
+using std::string;
+
+//--------------------------------------------------------------
+void ImageCache::Entry::wait() {
+	if( isDecoded() ) return;
+	std::unique_lock<std::mutex> lock( mMutex );
+	mDecodedCondition.wait( lock, [this]() { return isDecoded(); });
+}
+
+//--------------------------------------------------------------
+ofTexture* ImageCache::Entry::getTexture() {
+	if( mState.load() != STATE_DECODED ) {
+		return nullptr;
+	}
+	if( !mBUploaded ) {
+		mTexture.allocate( mPixels );
+		mBUploaded = true;
+	}
+	return &mTexture;
+}
+
+//--------------------------------------------------------------
+ImageCache& ImageCache::sGetShared() {
+	static ImageCache sCache;
+	return sCache;
+}
+
+//--------------------------------------------------------------
+ImageCache::~ImageCache() {
+	_stopWorkers();
+}
+
+//--------------------------------------------------------------
+shared_ptr<ImageCache::Entry> ImageCache::request( const of::filesystem::path& aPath, bool abAsync ) {
+	shared_ptr<Entry> tentry;
+	bool bNew = false;
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		auto key = _getKey( aPath );
+		auto it = mEntries.find( key );
+		if( it != mEntries.end() ) {
+			tentry = it->second;
+		} else {
+			tentry = std::make_shared<Entry>();
+			tentry->mPath = aPath;
+			mEntries[key] = tentry;
+			bNew = true;
+			if( abAsync ) {
+				mQueue.push_back( tentry );
+			}
+		}
+	}
+
+	if( bNew && abAsync ) {
+		_startWorkers();
+		mQueueCondition.notify_one();
+	} else if( bNew ) {
+		_decode( *tentry );
+	} else if( !abAsync ) {
+		// requested before, possibly still on a worker thread
+		tentry->wait();
+	}
+	return tentry;
+}
+
+//--------------------------------------------------------------
+shared_ptr<ImageCache::Entry> ImageCache::get( const of::filesystem::path& aPath ) {
+	std::lock_guard<std::mutex> lock( mMutex );
+	auto it = mEntries.find( _getKey( aPath ));
+	if( it != mEntries.end() ) {
+		return it->second;
+	}
+	return shared_ptr<Entry>();
+}
+
+//--------------------------------------------------------------
+void ImageCache::waitForAll() {
+	std::unique_lock<std::mutex> lock( mMutex );
+	mIdleCondition.wait( lock, [this]() { return mQueue.empty() && mNumDecoding == 0; });
+}
+
+//--------------------------------------------------------------
+std::size_t ImageCache::getNumPending() {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mQueue.size() + mNumDecoding;
+}
+
+//--------------------------------------------------------------
+std::size_t ImageCache::getNumEntries() {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mEntries.size();
+}
+
+//--------------------------------------------------------------
+void ImageCache::releaseUnused() {
+	std::lock_guard<std::mutex> lock( mMutex );
+	for( auto it = mEntries.begin(); it != mEntries.end(); ) {
+		// the cache and a possible queue reference are the only owners
+		if( it->second.use_count() == 1 && it->second->isDecoded() ) {
+			it = mEntries.erase( it );
+		} else {
+			++it;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ImageCache::clear() {
+	std::lock_guard<std::mutex> lock( mMutex );
+	// entries still being decoded are kept alive by the workers and elements holding them.
+	// Queued entries will never be decoded, so fail them to release anyone waiting on them.
+	for( auto& tentry : mQueue ) {
+		{
+			std::lock_guard<std::mutex> entryLock( tentry->mMutex );
+			tentry->mState = Entry::STATE_FAILED;
+		}
+		tentry->mDecodedCondition.notify_all();
+	}
+	mQueue.clear();
+	mEntries.clear();
+	mIdleCondition.notify_all();
+}
+
+//--------------------------------------------------------------
+void ImageCache::setNumThreads( std::size_t aNumThreads ) {
+	_stopWorkers();
+	bool bHasQueued = false;
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		mNumThreads = aNumThreads;
+		bHasQueued = !mQueue.empty();
+	}
+	if( bHasQueued ) {
+		_startWorkers();
+	}
+}
+
+//--------------------------------------------------------------
+string ImageCache::_getKey( const of::filesystem::path& aPath ) {
+	return aPath.lexically_normal().string();
+}
+
+//--------------------------------------------------------------
+void ImageCache::_decode( Entry& aEntry ) {
+	aEntry.mState = Entry::STATE_DECODING;
+	bool bOk = ofLoadImage( aEntry.mPixels, aEntry.mPath );
+	if( !bOk ) {
+		ofLogError(moduleName()) << __FUNCTION__ << " : unable to load image from " << aEntry.mPath.string();
+	}
+	{
+		std::lock_guard<std::mutex> lock( aEntry.mMutex );
+		aEntry.mState = bOk ? Entry::STATE_DECODED : Entry::STATE_FAILED;
+	}
+	aEntry.mDecodedCondition.notify_all();
+}
+
+//--------------------------------------------------------------
+void ImageCache::_startWorkers() {
+	std::lock_guard<std::mutex> lock( mMutex );
+	if( mWorkers.size() ) return;
+	std::size_t numThreads = mNumThreads;
+	if( numThreads < 1 ) {
+		numThreads = std::max( 1u, std::thread::hardware_concurrency() );
+	}
+	mBStopping = false;
+	for( std::size_t i = 0; i < numThreads; i++ ) {
+		mWorkers.emplace_back( &ImageCache::_workerLoop, this );
+	}
+}
+
+//--------------------------------------------------------------
+void ImageCache::_stopWorkers() {
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		mBStopping = true;
+	}
+	mQueueCondition.notify_all();
+	for( auto& worker : mWorkers ) {
+		if( worker.joinable() ) worker.join();
+	}
+	std::lock_guard<std::mutex> lock( mMutex );
+	mWorkers.clear();
+	mBStopping = false;
+}
+
+//--------------------------------------------------------------
+void ImageCache::_workerLoop() {
+	while( true ) {
+		shared_ptr<Entry> tentry;
+		{
+			std::unique_lock<std::mutex> lock( mMutex );
+			mQueueCondition.wait( lock, [this]() { return mBStopping || !mQueue.empty(); });
+			if( mBStopping ) {
+				return;
+			}
+			tentry = mQueue.front();
+			mQueue.pop_front();
+			mNumDecoding++;
+		}
+
+		_decode( *tentry );
+
+		{
+			std::lock_guard<std::mutex> lock( mMutex );
+			mNumDecoding--;
+			if( mQueue.empty() && mNumDecoding == 0 ) {
+				mIdleCondition.notify_all();
+			}
+		}
+	}
+}
@@ -0,0 +1,104 @@
+//
+//  ofxSvgImageCache.h
+//
+//  Decodes image files into ofPixels on worker threads and shares the pixels and
+//  textures between all of the Image elements that reference the same file.
+//  Only the texture upload happens on the gl thread, the first time it is drawn.
+//
+
+#pragma once
+#include "ofPixels.h"
+#include "ofTexture.h"
+#include "ofFileUtils.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace ofx::svg {
+class ImageCache {
+public:
+	class Entry {
+	public:
+		const of::filesystem::path& getPath() { return mPath; }
+
+		// true when decoding has finished, even if it failed
+		bool isDecoded() { return mState.load() >= STATE_DECODED; }
+		bool isUploaded() { return mBUploaded; }
+		bool isFailed() { return mState.load() == STATE_FAILED; }
+		// blocks until the file has been decoded
+		void wait();
+
+		// valid once isDecoded() returns true
+		const ofPixels& getPixels() { return mPixels; }
+		// uploads the pixels on the first call, must be called from the gl thread.
+		// returns nullptr while decoding or if decoding failed.
+		ofTexture* getTexture();
+
+	protected:
+		friend class ImageCache;
+		enum State {
+			STATE_QUEUED = 0,
+			STATE_DECODING,
+			STATE_DECODED,
+			STATE_FAILED
+		};
+
+		of::filesystem::path mPath;
+		ofPixels mPixels;
+		ofTexture mTexture;
+		bool mBUploaded = false;
+		std::atomic<int> mState{ STATE_QUEUED };
+		std::mutex mMutex;
+		std::condition_variable mDecodedCondition;
+	};
+
+	// cache shared by all of the documents, like the fonts in Text
+	static ImageCache& sGetShared();
+
+	~ImageCache();
+
+	// returns the entry for the file, scheduling it to be decoded on a worker thread the first time it is requested.
+	// When abAsync is false the file is decoded on the calling thread before returning.
+	std::shared_ptr<Entry> request( const of::filesystem::path& aPath, bool abAsync = true );
+	// nullptr if the file has not been requested
+	std::shared_ptr<Entry> get( const of::filesystem::path& aPath );
+
+	// blocks until all of the requested files have been decoded
+	void waitForAll();
+	std::size_t getNumPending();
+	std::size_t getNumEntries();
+
+	// drops the entries that are not referenced by any element anymore, called by Parser::load
+	void releaseUnused();
+	// drops all of the entries, queued files that were not decoded yet are marked as failed
+	void clear();
+
+	// number of worker threads, defaults to the number of hardware threads.
+	// Takes effect when the workers are started on the next async request.
+	void setNumThreads( std::size_t aNumThreads );
+
+	// will log messages to this module name
+	static const std::string moduleName() { return "ofx::svg::ImageCache"; }
+
+protected:
+	static std::string _getKey( const of::filesystem::path& aPath );
+	static void _decode( Entry& aEntry );
+	void _startWorkers();
+	void _stopWorkers();
+	void _workerLoop();
+
+	std::mutex mMutex;
+	std::condition_variable mQueueCondition;
+	std::condition_variable mIdleCondition;
+	std::deque< std::shared_ptr<Entry> > mQueue;
+	std::size_t mNumDecoding = 0;
+	std::unordered_map< std::string, std::shared_ptr<Entry> > mEntries;
+
+	std::vector< std::thread > mWorkers;
+	std::size_t mNumThreads = 0;
+	bool mBStopping = false;
+};
+}
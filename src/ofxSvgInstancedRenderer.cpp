@@ -0,0 +1,453 @@
+//
+//  ofxSvgInstancedRenderer.cpp
+//
+
+#include "ofxSvgInstancedRenderer.h"
+#include "ofxSvgGroup.h"
+#include "ofxSvgSpatialIndex.h"
+#include "ofGraphics.h"
+#include <cmath>
+
+using namespace ofx::svg;
+using std::string;
+using std::vector;
+using std::shared_ptr;
+
+static const string sInstancedVertexShader = R"(#version 150
+uniform mat4 modelViewProjectionMatrix;
+uniform vec4 globalColor;
+uniform float useInstanceColors;
+in vec4 position;
+in vec2 instanceTranslation;
+in vec4 instanceColor;
+out vec4 vColor;
+void main() {
+	vColor = mix( globalColor, instanceColor, useInstanceColors );
+	gl_Position = modelViewProjectionMatrix * ( position + vec4( instanceTranslation, 0.0, 0.0 ));
+}
+)";
+
+static const string sInstancedFragmentShader = R"(#version 150
+in vec4 vColor;
+out vec4 fragColor;
+void main() {
+	fragColor = vColor;
+}
+)";
+
+// outlines that differ by less than this after removing the translation are treated as the same geometry
+static const float sQuantizeScale = 1000.f;
+
+//--------------------------------------------------------------
+static void sHashCombine( std::size_t& aSeed, std::size_t aValue ) {
+	aSeed ^= aValue + 0x9e3779b9 + ( aSeed << 6 ) + ( aSeed >> 2 );
+}
+
+//--------------------------------------------------------------
+void InstancedRenderer::build( Group& aRoot ) {
+	clear();
+	vector<Item> titems;
+	_collectRecursive( aRoot, aRoot.pos, titems );
+	for( auto& item : titems ) {
+		_addItem( item );
+	}
+	mBAnyDirty = mBatches.size() > 0;
+}
+
+//--------------------------------------------------------------
+void InstancedRenderer::clear() {
+	mBatches.clear();
+	mGeometries.clear();
+	mBAnyDirty = false;
+}
+
+//--------------------------------------------------------------
+void InstancedRenderer::markDirty() {
+	for( auto& batch : mBatches ) {
+		batch.bDirty = true;
+	}
+	mBAnyDirty = mBatches.size() > 0;
+}
+
+//--------------------------------------------------------------
+std::size_t InstancedRenderer::getNumInstancedBatches() {
+	std::size_t numInstanced = 0;
+	for( auto& batch : mBatches ) {
+		if( batch.geometry ) numInstanced++;
+	}
+	return numInstanced;
+}
+
+//--------------------------------------------------------------
+std::size_t InstancedRenderer::getNumGeometries() {
+	std::size_t numGeometries = 0;
+	for( auto& iter : mGeometries ) {
+		numGeometries += iter.second.size();
+	}
+	return numGeometries;
+}
+
+//--------------------------------------------------------------
+std::size_t InstancedRenderer::getNumInstances() {
+	std::size_t numInstances = 0;
+	for( auto& batch : mBatches ) {
+		if( batch.geometry ) numInstances += batch.items.size();
+	}
+	return numInstances;
+}
+
+//--------------------------------------------------------------
+void InstancedRenderer::draw() {
+	if( mBAnyDirty ) {
+		mBAnyDirty = false;
+		for( auto& batch : mBatches ) {
+			if( batch.bDirty ) {
+				_updateBatch( batch );
+			}
+		}
+	}
+
+	ofPushStyle();
+	for( auto& batch : mBatches ) {
+		if( !batch.geometry ) {
+			for( auto& item : batch.items ) {
+				bool bTrans = item.offset.x != 0.f || item.offset.y != 0.f;
+				if( bTrans ) {
+					ofPushMatrix();
+					ofTranslate( item.offset.x, item.offset.y );
+				}
+				item.element->draw();
+				if( bTrans ) {
+					ofPopMatrix();
+				}
+			}
+			continue;
+		}
+		_drawBatch( batch );
+	}
+	ofPopStyle();
+}
+
+//--------------------------------------------------------------
+void InstancedRenderer::_collectRecursive( Group& aGroup, const glm::vec2& aOffset, vector<Item>& aItems ) {
+	const Group& cgroup = aGroup;
+	for( auto& kid : cgroup.getChildren() ) {
+		if( !kid ) continue;
+		auto etype = kid->getType();
+		if( etype == TYPE_GROUP ) {
+			auto& kgroup = static_cast<Group&>( *kid );
+			_collectRecursive( kgroup, aOffset + kgroup.pos, aItems );
+			continue;
+		}
+
+		Item item;
+		item.element = kid;
+		item.offset = aOffset;
+		if( etype == TYPE_PATH || etype == TYPE_RECTANGLE || etype == TYPE_CIRCLE || etype == TYPE_ELLIPSE ) {
+			glm::vec2 torigin;
+			item.geometry = _getGeometry( static_cast<Path&>( *kid ), torigin );
+			item.origin = torigin + aOffset;
+			if( item.geometry ) {
+				item.geometry->numPaths++;
+			}
+		}
+		aItems.push_back( item );
+	}
+}
+
+//--------------------------------------------------------------
+shared_ptr<InstancedRenderer::Geometry> InstancedRenderer::_getGeometry( Path& aPath, glm::vec2& aOrigin ) {
+	bool bFill = aPath.isFilled();
+	bool bStroke = aPath.hasStroke();
+	if( !bFill && !bStroke ) {
+		return shared_ptr<Geometry>();
+	}
+
+	const auto& outlines = aPath.path.getOutline();
+	aOrigin = glm::vec2( 0.f, 0.f );
+	bool bHasOrigin = false;
+	for( auto& outline : outlines ) {
+		if( outline.size() ) {
+			aOrigin = glm::vec2( outline.getVertices()[0] );
+			bHasOrigin = true;
+			break;
+		}
+	}
+	if( !bHasOrigin ) {
+		return shared_ptr<Geometry>();
+	}
+
+	vector<int> tkey;
+	for( auto& outline : outlines ) {
+		const auto& tverts = outline.getVertices();
+		tkey.push_back( (int)tverts.size() );
+		tkey.push_back( outline.isClosed() ? 1 : 0 );
+		for( auto& v : tverts ) {
+			tkey.push_back( (int)std::round(( v.x - aOrigin.x ) * sQuantizeScale ));
+			tkey.push_back( (int)std::round(( v.y - aOrigin.y ) * sQuantizeScale ));
+		}
+	}
+
+	float tstrokeWidth = bStroke ? aPath.getStrokeWidth() : 0.f;
+	bool bStrokeTriangles = bStroke && aPath.isStrokeTessellationEnabled();
+	StrokeStyle tstrokeStyle = bStrokeTriangles ? aPath.getStrokeStyle() : StrokeStyle();
+	auto twinding = aPath.path.getWindingMode();
+	std::size_t thash = tkey.size();
+	for( auto k : tkey ) {
+		sHashCombine( thash, std::hash<int>()( k ));
+	}
+	sHashCombine( thash, std::hash<int>()(( bFill ? 1 : 0 ) | ( bStroke ? 2 : 0 )));
+	sHashCombine( thash, std::hash<float>()( tstrokeWidth ));
+	sHashCombine( thash, std::hash<int>()( (int)twinding ));
+	sHashCombine( thash, std::hash<int>()(( bStrokeTriangles ? 1 : 0 ) | ( (int)tstrokeStyle.lineJoin << 1 ) | ( (int)tstrokeStyle.lineCap << 3 )));
+	sHashCombine( thash, std::hash<float>()( tstrokeStyle.miterLimit ));
+
+	auto& candidates = mGeometries[ thash ];
+	for( auto& geometry : candidates ) {
+		// the hashes can collide, compare the outlines
+		if( geometry->bFill == bFill && geometry->bStroke == bStroke && geometry->strokeWidth == tstrokeWidth &&
+			geometry->windingMode == twinding && geometry->bStrokeTriangles == bStrokeTriangles &&
+			geometry->strokeStyle == tstrokeStyle && geometry->key == tkey ) {
+			return geometry;
+		}
+	}
+
+	auto geometry = std::make_shared<Geometry>();
+	geometry->hash = thash;
+	geometry->key = std::move( tkey );
+	geometry->bFill = bFill;
+	geometry->bStroke = bStroke;
+	geometry->strokeWidth = tstrokeWidth;
+	geometry->bStrokeTriangles = bStrokeTriangles;
+	geometry->strokeStyle = tstrokeStyle;
+	geometry->windingMode = twinding;
+	_tessellate( *geometry, aPath, aOrigin );
+	candidates.push_back( geometry );
+	return geometry;
+}
+
+//--------------------------------------------------------------
+void InstancedRenderer::_addItem( const Item& aItem ) {
+	ofRectangle tbounds;
+	if( !SpatialIndex::sComputeBounds( *aItem.element, aItem.offset, tbounds )) {
+		// nothing to draw
+		return;
+	}
+
+	// shapes without enough copies are drawn by themselves
+	shared_ptr<Geometry> tgeometry;
+	if( aItem.geometry && (int)aItem.geometry->numPaths >= mMinInstances ) {
+		tgeometry = aItem.geometry;
+	}
+	bool bUseColors = aItem.element->bUseShapeColor;
+
+	// find a batch with the same geometry that this item can be merged into
+	// without being drawn on top of something that was added after that batch
+	int targetIndex = -1;
+	std::size_t numLookedAt = 0;
+	for( std::size_t i = mBatches.size(); i-- > 0 && numLookedAt < sMaxMergeLookback; numLookedAt++ ) {
+		auto& batch = mBatches[i];
+		bool bIntersects = batch.bHasBounds && batch.bounds.intersects( tbounds );
+		if( batch.geometry == tgeometry && ( !tgeometry || batch.bUseColors == bUseColors )) {
+			// all of the fills of a batch are drawn before its strokes,
+			// so overlapping copies with both can not share a batch
+			if( !( bIntersects && tgeometry && tgeometry->bFill && tgeometry->bStroke )) {
+				targetIndex = (int)i;
+			}
+			break;
+		}
+		if( bIntersects ) {
+			break;
+		}
+	}
+
+	if( targetIndex < 0 ) {
+		mBatches.push_back( Batch() );
+		auto& batch = mBatches.back();
+		batch.geometry = tgeometry;
+		batch.bUseColors = bUseColors;
+		targetIndex = (int)mBatches.size() - 1;
+	}
+
+	auto& batch = mBatches[targetIndex];
+	if( batch.bHasBounds ) {
+		batch.bounds.growToInclude( tbounds );
+	} else {
+		batch.bounds = tbounds;
+		batch.bHasBounds = true;
+	}
+	batch.items.push_back( aItem );
+	batch.bDirty = true;
+}
+
+//--------------------------------------------------------------
+void InstancedRenderer::_tessellate( Geometry& aGeometry, Path& aPath, const glm::vec2& aOrigin ) {
+	glm::vec3 torigin( aOrigin.x, aOrigin.y, 0.f );
+	if( aGeometry.bFill ) {
+		const ofMesh& tess = aPath.path.getTessellation();
+		const auto& tverts = tess.getVertices();
+		if( tverts.size() >= 3 ) {
+			for( auto& v : tverts ) {
+				aGeometry.fillMesh.addVertex( v - torigin );
+			}
+			const auto& tindices = tess.getIndices();
+			if( tindices.size() ) {
+				aGeometry.fillMesh.addIndices( tindices );
+			} else {
+				for( std::size_t i = 0; i < tverts.size(); i++ ) {
+					aGeometry.fillMesh.addIndex( (ofIndexType)i );
+				}
+			}
+		}
+	}
+
+	if( aGeometry.bStrokeTriangles ) {
+		const ofMesh& tstroke = aPath.getStrokeMesh();
+		for( auto& v : tstroke.getVertices() ) {
+			aGeometry.strokeMesh.addVertex( v - torigin );
+		}
+		aGeometry.strokeMesh.addIndices( tstroke.getIndices() );
+	} else if( aGeometry.bStroke ) {
+		// same lines as the batch renderer
+		for( auto& outline : aPath.path.getOutline() ) {
+			const auto& tverts = outline.getVertices();
+			if( tverts.size() < 2 ) continue;
+			ofIndexType baseIndex = (ofIndexType)aGeometry.strokeMesh.getNumVertices();
+			for( auto& v : tverts ) {
+				aGeometry.strokeMesh.addVertex( v - torigin );
+			}
+			ofIndexType numVerts = (ofIndexType)tverts.size();
+			for( ofIndexType i = 0; i + 1 < numVerts; i++ ) {
+				aGeometry.strokeMesh.addIndex( baseIndex + i );
+				aGeometry.strokeMesh.addIndex( baseIndex + i + 1 );
+			}
+			if( outline.isClosed() ) {
+				aGeometry.strokeMesh.addIndex( baseIndex + numVerts - 1 );
+				aGeometry.strokeMesh.addIndex( baseIndex );
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void InstancedRenderer::_updateBatch( Batch& aBatch ) {
+	aBatch.bDirty = false;
+	if( !aBatch.geometry ) {
+		return;
+	}
+	auto& geometry = *aBatch.geometry;
+
+	aBatch.translations.clear();
+	aBatch.fillColors.clear();
+	aBatch.strokeColors.clear();
+	aBatch.numVisible = 0;
+	for( auto& item : aBatch.items ) {
+		if( !item.element->isVisible() ) continue;
+		auto& tpath = static_cast<Path&>( *item.element );
+		aBatch.translations.push_back( item.origin.x );
+		aBatch.translations.push_back( item.origin.y );
+		ofFloatColor tfill = tpath.getFillColor();
+		ofFloatColor tstroke = tpath.getStrokeColor();
+		aBatch.fillColors.insert( aBatch.fillColors.end(), { tfill.r, tfill.g, tfill.b, tfill.a } );
+		aBatch.strokeColors.insert( aBatch.strokeColors.end(), { tstroke.r, tstroke.g, tstroke.b, tstroke.a } );
+		aBatch.numVisible++;
+	}
+
+	if( !aBatch.bUploaded ) {
+		if( geometry.fillMesh.getNumIndices() ) {
+			aBatch.fillVbo.setMesh( geometry.fillMesh, GL_STATIC_DRAW );
+		}
+		if( geometry.strokeMesh.getNumIndices() ) {
+			aBatch.strokeVbo.setMesh( geometry.strokeMesh, GL_STATIC_DRAW );
+		}
+		aBatch.bUploaded = true;
+	}
+
+	// without the programmable renderer the copies are drawn one by one from the same vbo
+	if( aBatch.numVisible < 1 || !ofIsGLProgrammableRenderer() ) {
+		return;
+	}
+	if( geometry.fillMesh.getNumIndices() ) {
+		aBatch.fillVbo.setAttributeData( sTranslationAttribute, aBatch.translations.data(), 2, aBatch.numVisible, GL_DYNAMIC_DRAW, sizeof(float) * 2 );
+		aBatch.fillVbo.setAttributeDivisor( sTranslationAttribute, 1 );
+		aBatch.fillVbo.setAttributeData( sColorAttribute, aBatch.fillColors.data(), 4, aBatch.numVisible, GL_DYNAMIC_DRAW, sizeof(float) * 4 );
+		aBatch.fillVbo.setAttributeDivisor( sColorAttribute, 1 );
+	}
+	if( geometry.strokeMesh.getNumIndices() ) {
+		aBatch.strokeVbo.setAttributeData( sTranslationAttribute, aBatch.translations.data(), 2, aBatch.numVisible, GL_DYNAMIC_DRAW, sizeof(float) * 2 );
+		aBatch.strokeVbo.setAttributeDivisor( sTranslationAttribute, 1 );
+		aBatch.strokeVbo.setAttributeData( sColorAttribute, aBatch.strokeColors.data(), 4, aBatch.numVisible, GL_DYNAMIC_DRAW, sizeof(float) * 4 );
+		aBatch.strokeVbo.setAttributeDivisor( sColorAttribute, 1 );
+	}
+}
+
+//--------------------------------------------------------------
+void InstancedRenderer::_drawBatch( Batch& aBatch ) {
+	if( aBatch.numVisible < 1 ) return;
+	auto& geometry = *aBatch.geometry;
+	int numFillIndices = (int)geometry.fillMesh.getNumIndices();
+	int numStrokeIndices = (int)geometry.strokeMesh.getNumIndices();
+
+	if( ofIsGLProgrammableRenderer() ) {
+		auto& tshader = _getShader();
+		tshader.begin();
+		tshader.setUniform1f( "useInstanceColors", aBatch.bUseColors ? 1.f : 0.f );
+		if( numFillIndices > 0 ) {
+			aBatch.fillVbo.drawElementsInstanced( GL_TRIANGLES, numFillIndices, aBatch.numVisible );
+		}
+		if( numStrokeIndices > 0 ) {
+			if( geometry.bStrokeTriangles ) {
+				aBatch.strokeVbo.drawElementsInstanced( GL_TRIANGLES, numStrokeIndices, aBatch.numVisible );
+			} else {
+				ofSetLineWidth( geometry.strokeWidth );
+				aBatch.strokeVbo.drawElementsInstanced( GL_LINES, numStrokeIndices, aBatch.numVisible );
+			}
+		}
+		tshader.end();
+		return;
+	}
+
+	// fixed function fallback, still skips the tessellation and the upload per path
+	for( int i = 0; i < aBatch.numVisible; i++ ) {
+		ofPushMatrix();
+		ofTranslate( aBatch.translations[i * 2], aBatch.translations[i * 2 + 1] );
+		if( numFillIndices > 0 ) {
+			if( aBatch.bUseColors ) {
+				const float* tc = &aBatch.fillColors[i * 4];
+				ofSetColor( ofFloatColor( tc[0], tc[1], tc[2], tc[3] ));
+			}
+			aBatch.fillVbo.drawElements( GL_TRIANGLES, numFillIndices );
+		}
+		if( numStrokeIndices > 0 ) {
+			if( aBatch.bUseColors ) {
+				const float* tc = &aBatch.strokeColors[i * 4];
+				ofSetColor( ofFloatColor( tc[0], tc[1], tc[2], tc[3] ));
+			}
+			if( geometry.bStrokeTriangles ) {
+				aBatch.strokeVbo.drawElements( GL_TRIANGLES, numStrokeIndices );
+			} else {
+				ofSetLineWidth( geometry.strokeWidth );
+				aBatch.strokeVbo.drawElements( GL_LINES, numStrokeIndices );
+			}
+		}
+		ofPopMatrix();
+	}
+}
+
+//--------------------------------------------------------------
+ofShader& InstancedRenderer::_getShader() {
+	static ofShader sShader;
+	static bool sBLoaded = false;
+	if( !sBLoaded ) {
+		sBLoaded = true;
+		sShader.setupShaderFromSource( GL_VERTEX_SHADER, sInstancedVertexShader );
+		sShader.setupShaderFromSource( GL_FRAGMENT_SHADER, sInstancedFragmentShader );
+		sShader.bindDefaults();
+		sShader.bindAttribute( sTranslationAttribute, "instanceTranslation" );
+		sShader.bindAttribute( sColorAttribute, "instanceColor" );
+		if( !sShader.linkProgram() ) {
+			ofLogError(moduleName()) << __FUNCTION__ << " : unable to link the instancing shader";
+		}
+	}
+	return sShader;
+}
@@ -0,0 +1,118 @@
+//
+//  ofxSvgInstancedRenderer.h
+//
+//  Draws paths that share the same geometry, like the copies created from <use> elements,
+//  with one instanced draw call. The geometry is tessellated once and each copy only adds
+//  a translation and a color to an instance buffer. Everything else is drawn element by element,
+//  in the order of the document.
+//
+
+#pragma once
+#include "ofxSvgElements.h"
+#include "ofVbo.h"
+#include "ofShader.h"
+#include <unordered_map>
+
+namespace ofx::svg {
+class Group;
+
+class InstancedRenderer {
+public:
+	// groups the paths below aRoot by geometry, call again after adding or removing elements
+	// or when the shape, fill or stroke of a path changes.
+	void build( Group& aRoot );
+	void clear();
+
+	// uploads the instance colors and visibility again on the next draw.
+	// Moving an element can change the draw order, call build() instead.
+	void markDirty();
+	void draw();
+
+	// geometry needs at least this many copies to be drawn instanced
+	void setMinInstances( int aMinInstances ) { mMinInstances = std::max( 2, aMinInstances ); }
+	int getMinInstances() { return mMinInstances; }
+
+	bool isEmpty() { return mBatches.empty(); }
+	std::size_t getNumBatches() { return mBatches.size(); }
+	std::size_t getNumInstancedBatches();
+	std::size_t getNumGeometries();
+	// paths that are drawn instanced
+	std::size_t getNumInstances();
+
+	// will log messages to this module name
+	static const std::string moduleName() { return "ofx::svg::InstancedRenderer"; }
+
+protected:
+	// tessellation shared by all of the copies, relative to the first outline vertex of the path
+	class Geometry {
+	public:
+		std::size_t hash = 0;
+		// quantized outline vertices relative to the origin, after the vertex count and closed flag of each outline
+		std::vector<int> key;
+		bool bFill = false;
+		bool bStroke = false;
+		float strokeWidth = 1.f;
+		// the stroke mesh holds the tessellated stroke instead of lines, see Path::getStrokeMesh
+		bool bStrokeTriangles = false;
+		StrokeStyle strokeStyle;
+		ofPolyWindingMode windingMode = OF_POLY_WINDING_ODD;
+
+		ofMesh fillMesh;
+		ofMesh strokeMesh;
+		std::size_t numPaths = 0;
+	};
+
+	struct Item {
+		std::shared_ptr<Element> element;
+		// accumulated positions of the parent groups
+		glm::vec2 offset;
+		// first outline vertex in document space, where the geometry is placed
+		glm::vec2 origin;
+		// nullptr for elements that are not paths
+		std::shared_ptr<Geometry> geometry;
+	};
+
+	struct Batch {
+		// nullptr for batches of elements that are drawn one by one
+		std::shared_ptr<Geometry> geometry;
+		bool bUseColors = true;
+
+		ofRectangle bounds;
+		bool bHasBounds = false;
+		std::vector<Item> items;
+
+		// the geometry and the instance attributes of the visible items
+		ofVbo fillVbo;
+		ofVbo strokeVbo;
+		std::vector<float> translations;
+		std::vector<float> fillColors;
+		std::vector<float> strokeColors;
+		int numVisible = 0;
+		// the geometry is uploaded once, the instance attributes when the batch is dirty
+		bool bUploaded = false;
+		bool bDirty = true;
+	};
+
+	void _collectRecursive( Group& aGroup, const glm::vec2& aOffset, std::vector<Item>& aItems );
+	// returns the shared geometry for the path, creating it the first time the shape is seen
+	std::shared_ptr<Geometry> _getGeometry( Path& aPath, glm::vec2& aOrigin );
+	// aItem.geometry is nullptr when the element is drawn by itself
+	void _addItem( const Item& aItem );
+	void _tessellate( Geometry& aGeometry, Path& aPath, const glm::vec2& aOrigin );
+	void _updateBatch( Batch& aBatch );
+	void _drawBatch( Batch& aBatch );
+	static ofShader& _getShader();
+
+	// attribute locations for the instance buffers, after the ones that openFrameworks uses
+	static const int sTranslationAttribute = 4;
+	static const int sColorAttribute = 5;
+	// how many batches back to look for one with the same geometry before starting a new batch
+	static const std::size_t sMaxMergeLookback = 8;
+
+	int mMinInstances = 2;
+	std::vector<Batch> mBatches;
+	// geometries by the hash of their outlines
+	std::unordered_map< std::size_t, std::vector< std::shared_ptr<Geometry> > > mGeometries;
+	bool mBAnyDirty = false;
+};
+}
@@ -0,0 +1,121 @@
+//
+//  ofxSvgLodBuilder.cpp
+//
+
+#include "ofxSvgLodBuilder.h"
+
+using namespace ofx::svg;
+using std::shared_ptr;
+
+//--------------------------------------------------------------
+LodBuilder& LodBuilder::sGetShared() {
+	static LodBuilder sBuilder;
+	return sBuilder;
+}
+
+//--------------------------------------------------------------
+LodBuilder::~LodBuilder() {
+	_stopWorkers();
+}
+
+//--------------------------------------------------------------
+shared_ptr<LodBuilder::Job> LodBuilder::request( std::function< Outlines() > aFunction ) {
+	auto tjob = std::make_shared<Job>();
+	tjob->mFunction = std::move( aFunction );
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		mQueue.push_back( tjob );
+	}
+	_startWorkers();
+	mQueueCondition.notify_one();
+	return tjob;
+}
+
+//--------------------------------------------------------------
+void LodBuilder::waitForAll() {
+	std::unique_lock<std::mutex> lock( mMutex );
+	mIdleCondition.wait( lock, [this]() { return mQueue.empty() && mNumBuilding == 0; });
+}
+
+//--------------------------------------------------------------
+std::size_t LodBuilder::getNumPending() {
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mQueue.size() + mNumBuilding;
+}
+
+//--------------------------------------------------------------
+void LodBuilder::setNumThreads( std::size_t aNumThreads ) {
+	_stopWorkers();
+	bool bHasQueued = false;
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		mNumThreads = aNumThreads;
+		bHasQueued = !mQueue.empty();
+	}
+	if( bHasQueued ) {
+		_startWorkers();
+	}
+}
+
+//--------------------------------------------------------------
+void LodBuilder::_startWorkers() {
+	std::lock_guard<std::mutex> lock( mMutex );
+	if( mWorkers.size() ) return;
+	std::size_t numThreads = mNumThreads;
+	if( numThreads < 1 ) {
+		// leave room for the gl thread and the image decoders
+		numThreads = std::max( 1u, std::thread::hardware_concurrency() / 2 );
+	}
+	mBStopping = false;
+	for( std::size_t i = 0; i < numThreads; i++ ) {
+		mWorkers.emplace_back( &LodBuilder::_workerLoop, this );
+	}
+}
+
+//--------------------------------------------------------------
+void LodBuilder::_stopWorkers() {
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		mBStopping = true;
+	}
+	mQueueCondition.notify_all();
+	for( auto& worker : mWorkers ) {
+		if( worker.joinable() ) worker.join();
+	}
+	std::lock_guard<std::mutex> lock( mMutex );
+	mWorkers.clear();
+	mBStopping = false;
+}
+
+//--------------------------------------------------------------
+void LodBuilder::_workerLoop() {
+	while( true ) {
+		shared_ptr<Job> tjob;
+		{
+			std::unique_lock<std::mutex> lock( mMutex );
+			mQueueCondition.wait( lock, [this]() { return mBStopping || !mQueue.empty(); });
+			if( mBStopping ) {
+				return;
+			}
+			tjob = mQueue.front();
+			mQueue.pop_front();
+			mNumBuilding++;
+		}
+
+		// skipped when the queue held the last reference, the path has been cleared or destroyed
+		if( tjob.use_count() > 1 ) {
+			tjob->mOutlines = tjob->mFunction();
+		}
+		tjob->mFunction = nullptr;
+		tjob->mBDone = true;
+		tjob.reset();
+
+		{
+			std::lock_guard<std::mutex> lock( mMutex );
+			mNumBuilding--;
+			if( mQueue.empty() && mNumBuilding == 0 ) {
+				mIdleCondition.notify_all();
+			}
+		}
+	}
+}
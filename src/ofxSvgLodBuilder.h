@@ -0,0 +1,73 @@
+//
+//  ofxSvgLodBuilder.h
+//
+//  Builds the simplified outlines for the levels of detail of paths on a small fixed pool of
+//  worker threads, so drawing a document with many paths for the first time does not start a
+//  thread per path.
+//
+
+#pragma once
+#include "ofPolyline.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ofx::svg {
+class LodBuilder {
+public:
+	// the outlines of each level, finest first
+	typedef std::vector< std::vector<ofPolyline> > Outlines;
+
+	class Job {
+	public:
+		// true once the worker has built the outlines
+		bool isDone() { return mBDone.load(); }
+		// valid once isDone() returns true
+		const Outlines& getOutlines() { return mOutlines; }
+
+	protected:
+		friend class LodBuilder;
+		std::function< Outlines() > mFunction;
+		Outlines mOutlines;
+		std::atomic<bool> mBDone{ false };
+	};
+
+	// pool shared by all of the documents, like the ImageCache
+	static LodBuilder& sGetShared();
+
+	~LodBuilder();
+
+	// queues aFunction to run on one of the workers. Jobs that are no longer referenced by anyone
+	// when a worker gets to them are skipped, so releasing the job cancels it without blocking.
+	std::shared_ptr<Job> request( std::function< Outlines() > aFunction );
+
+	// blocks until all of the queued jobs have been built or skipped
+	void waitForAll();
+	std::size_t getNumPending();
+
+	// number of worker threads, defaults to half of the hardware threads.
+	// Takes effect when the workers are started on the next request.
+	void setNumThreads( std::size_t aNumThreads );
+
+	// will log messages to this module name
+	static const std::string moduleName() { return "ofx::svg::LodBuilder"; }
+
+protected:
+	void _startWorkers();
+	void _stopWorkers();
+	void _workerLoop();
+
+	std::mutex mMutex;
+	std::condition_variable mQueueCondition;
+	std::condition_variable mIdleCondition;
+	std::deque< std::shared_ptr<Job> > mQueue;
+	std::size_t mNumBuilding = 0;
+
+	std::vector< std::thread > mWorkers;
+	std::size_t mNumThreads = 0;
+	bool mBStopping = false;
+};
+}
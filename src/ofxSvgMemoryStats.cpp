@@ -0,0 +1,184 @@
+//
+//  ofxSvgMemoryStats.cpp
+//
+
+#include "ofxSvgMemoryStats.h"
+#include "ofxSvgGroup.h"
+#include "ofxSvgCss.h"
+#include <algorithm>
+#include <sstream>
+
+using namespace ofx::svg;
+using std::vector;
+using std::shared_ptr;
+using std::string;
+
+//--------------------------------------------------------------
+MemoryUsage& MemoryUsage::operator+=( const MemoryUsage& aOther ) {
+	elements += aOther.elements;
+	pathGeometry += aOther.pathGeometry;
+	styles += aOther.styles;
+	textMeshes += aOther.textMeshes;
+	images += aOther.images;
+	strings += aOther.strings;
+	return *this;
+}
+
+//--------------------------------------------------------------
+std::size_t MemoryUsage::sGetNumBytes( const ofMesh& aMesh ) {
+	return sGetNumBytes( aMesh.getVertices() ) + sGetNumBytes( aMesh.getColors() ) + sGetNumBytes( aMesh.getTexCoords() ) + sGetNumBytes( aMesh.getIndices() );
+}
+
+//--------------------------------------------------------------
+std::size_t MemoryUsage::sGetNumBytes( const ofPath& aPath ) {
+	// the const accessor, so the outlines are not flagged as changed
+	return sGetNumBytes( aPath.getCommands() );
+}
+
+//--------------------------------------------------------------
+std::size_t MemoryUsage::sGetNumBytes( const CssClass& aClass ) {
+	std::size_t tbytes = sizeof(CssClass) + sGetNumBytes( aClass.name );
+	// one node per property plus the bucket array
+	tbytes += aClass.properties.bucket_count() * sizeof(void*);
+	for( auto& tprop : aClass.properties ) {
+		tbytes += sizeof(tprop) + 2 * sizeof(void*);
+		tbytes += sGetNumBytes( tprop.first );
+		tbytes += sGetNumBytes( tprop.second.srcString );
+		if( tprop.second.svalue.has_value() ) {
+			tbytes += sGetNumBytes( tprop.second.svalue.value() );
+		}
+	}
+	return tbytes;
+}
+
+//--------------------------------------------------------------
+MemoryStats::MemoryStats() {
+	clear();
+}
+
+//--------------------------------------------------------------
+void MemoryStats::clear() {
+	usage = MemoryUsage();
+	bytesByType.fill( 0 );
+	numElementsByType.fill( 0 );
+	numElements = 0;
+	heaviestElements.clear();
+	mCounted.clear();
+}
+
+//--------------------------------------------------------------
+void MemoryStats::addElements( const vector< shared_ptr<Element> >& aElements ) {
+	for( auto& ele : aElements ) {
+		_addElement( ele );
+	}
+}
+
+//--------------------------------------------------------------
+void MemoryStats::addStyleSheet( CssStyleSheet& aStyleSheet ) {
+	usage.styles += aStyleSheet.classes.bucket_count() * sizeof(void*);
+	for( auto& tclass : aStyleSheet.classes ) {
+		usage.styles += MemoryUsage::sGetNumBytes( tclass.first ) + MemoryUsage::sGetNumBytes( tclass.second ) + 2 * sizeof(void*);
+	}
+}
+
+//--------------------------------------------------------------
+void MemoryStats::finish( std::size_t aNumHeaviest ) {
+	auto theavier = []( const ElementUsage& a, const ElementUsage& b ) {
+		return a.usage.getTotal() > b.usage.getTotal();
+	};
+	if( heaviestElements.size() > aNumHeaviest ) {
+		std::partial_sort( heaviestElements.begin(), heaviestElements.begin() + aNumHeaviest, heaviestElements.end(), theavier );
+		heaviestElements.resize( aNumHeaviest );
+	} else {
+		std::sort( heaviestElements.begin(), heaviestElements.end(), theavier );
+	}
+}
+
+//--------------------------------------------------------------
+string MemoryStats::toString() {
+	std::stringstream ss;
+	ss << "total: " << getTotal() << " bytes in " << numElements << " elements" << std::endl;
+	ss << "   elements: " << usage.elements << std::endl;
+	ss << "   path geometry: " << usage.pathGeometry << std::endl;
+	ss << "   styles: " << usage.styles << std::endl;
+	ss << "   text meshes: " << usage.textMeshes << std::endl;
+	ss << "   images: " << usage.images << std::endl;
+	ss << "   strings: " << usage.strings << std::endl;
+	for( int i = 0; i < TYPE_TOTAL; i++ ) {
+		if( numElementsByType[i] < 1 ) continue;
+		ss << "   " << Element::sGetTypeAsString( (SvgType)i ) << ": " << numElementsByType[i] << " elements, " << bytesByType[i] << " bytes" << std::endl;
+	}
+	for( auto& theavy : heaviestElements ) {
+		ss << "   " << theavy.element->getTypeAsString() << " - " << theavy.element->getName() << " : " << theavy.usage.getTotal() << " bytes" << std::endl;
+	}
+	return ss.str();
+}
+
+//--------------------------------------------------------------
+std::size_t MemoryStats::_sGetObjectSize( SvgType aType ) {
+	switch( aType ) {
+		case TYPE_GROUP:
+			return sizeof(Group);
+		case TYPE_RECTANGLE:
+			return sizeof(Rectangle);
+		case TYPE_IMAGE:
+			return sizeof(Image);
+		case TYPE_ELLIPSE:
+			return sizeof(Ellipse);
+		case TYPE_CIRCLE:
+			return sizeof(Circle);
+		case TYPE_PATH:
+			return sizeof(Path);
+		case TYPE_TEXT:
+			return sizeof(Text);
+		default:
+			break;
+	}
+	return sizeof(Element);
+}
+
+//--------------------------------------------------------------
+void MemoryStats::_addElement( const shared_ptr<Element>& aElement ) {
+	if( !aElement || !mCounted.insert( aElement.get() ).second ) {
+		return;
+	}
+
+	SvgType ttype = aElement->getType();
+	MemoryUsage tusage;
+	tusage.elements = _sGetObjectSize( ttype );
+	aElement->addMemoryUsage( tusage );
+
+	auto timage = ttype == TYPE_IMAGE ? std::dynamic_pointer_cast<Image>( aElement ) : shared_ptr<Image>();
+	if( timage ) {
+		auto& tentry = timage->cacheEntry;
+		if( tentry && tentry->isDecoded() && mCounted.insert( tentry.get() ).second ) {
+			std::size_t tnumBytes = tentry->getPixels().getTotalBytes();
+			tusage.images += tnumBytes;
+			if( tentry->isUploaded() ) {
+				tusage.images += tnumBytes;
+			}
+		}
+		auto& tpage = timage->atlasPage;
+		if( tpage && mCounted.insert( tpage.get() ).second ) {
+			std::size_t tnumBytes = tpage->getPixels().getTotalBytes();
+			tusage.images += tnumBytes;
+			if( tpage->isUploaded() ) {
+				tusage.images += tnumBytes;
+			}
+		}
+	}
+
+	usage += tusage;
+	numElements++;
+	if( ttype < TYPE_TOTAL ) {
+		numElementsByType[ttype]++;
+		bytesByType[ttype] += tusage.getTotal();
+	}
+
+	if( aElement->isGroup() ) {
+		const Group& tgroup = static_cast<const Group&>( *aElement );
+		addElements( tgroup.getChildren() );
+	} else {
+		heaviestElements.push_back( { aElement, tusage } );
+	}
+}
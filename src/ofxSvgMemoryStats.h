@@ -0,0 +1,92 @@
+//
+//  ofxSvgMemoryStats.h
+//
+//  Approximate memory used by a loaded document, split into categories and element types.
+//  The sizes are computed from the capacities of the containers, without the overhead of the
+//  heap allocator. Texture sizes are estimated from the pixels that were uploaded.
+//
+
+#pragma once
+#include "ofxSvgElements.h"
+#include <array>
+#include <unordered_set>
+
+namespace ofx::svg {
+class CssClass;
+class CssStyleSheet;
+
+// bytes held by an element or a document, see Element::addMemoryUsage
+class MemoryUsage {
+public:
+	// the element objects, the child lists of the groups and the text spans
+	std::size_t elements = 0;
+	// path commands, level of detail outlines and tessellated stroke meshes
+	std::size_t pathGeometry = 0;
+	// css classes and their properties
+	std::size_t styles = 0;
+	// text meshes and the batches that draw them
+	std::size_t textMeshes = 0;
+	// decoded pixels, uploaded textures and atlas pages
+	std::size_t images = 0;
+	// heap storage of names, text, file paths and the string table
+	std::size_t strings = 0;
+
+	std::size_t getTotal() const { return elements + pathGeometry + styles + textMeshes + images + strings; }
+	MemoryUsage& operator+=( const MemoryUsage& aOther );
+
+	template<typename T>
+	static std::size_t sGetNumBytes( const std::vector<T>& aVec ) { return aVec.capacity() * sizeof(T); }
+	// only the heap storage, short strings are stored in the string object
+	template<typename C>
+	static std::size_t sGetNumBytes( const std::basic_string<C>& aStr ) {
+		if( aStr.capacity() * sizeof(C) < sizeof(std::basic_string<C>) ) {
+			return 0;
+		}
+		return ( aStr.capacity() + 1 ) * sizeof(C);
+	}
+	static std::size_t sGetNumBytes( const ofMesh& aMesh );
+	static std::size_t sGetNumBytes( const ofPath& aPath );
+	// the class object, its properties and their strings
+	static std::size_t sGetNumBytes( const CssClass& aClass );
+};
+
+class MemoryStats {
+public:
+	class ElementUsage {
+	public:
+		std::shared_ptr<Element> element;
+		MemoryUsage usage;
+	};
+
+	MemoryUsage usage;
+	std::size_t getTotal() const { return usage.getTotal(); }
+
+	// indexed by SvgType, the bytes of the groups do not include their children
+	std::array<std::size_t, TYPE_TOTAL> bytesByType;
+	std::array<std::size_t, TYPE_TOTAL> numElementsByType;
+	std::size_t numElements = 0;
+
+	// elements other than groups, sorted by their total bytes, heaviest first.
+	// Shared images are counted for the first element that draws them.
+	std::vector<ElementUsage> heaviestElements;
+
+	MemoryStats();
+	void clear();
+	// walks the hierarchy, elements and images that were already added are skipped
+	void addElements( const std::vector< std::shared_ptr<Element> >& aElements );
+	void addStyleSheet( CssStyleSheet& aStyleSheet );
+	// sorts the elements and keeps the aNumHeaviest heaviest
+	void finish( std::size_t aNumHeaviest );
+
+	std::string toString();
+
+	// will log messages to this module name
+	static const std::string moduleName() { return "ofx::svg::MemoryStats"; }
+
+protected:
+	static std::size_t _sGetObjectSize( SvgType aType );
+	void _addElement( const std::shared_ptr<Element>& aElement );
+
+	std::unordered_set<const void*> mCounted;
+};
+}
@@ -0,0 +1,110 @@
+//
+//  ofxSvgNameSubstringIndex.cpp
+//
+
+#include "ofxSvgNameSubstringIndex.h"
+#include <algorithm>
+
+using namespace ofx::svg;
+using std::vector;
+using std::string;
+
+//--------------------------------------------------------------
+void NameSubstringIndex::build( const vector< std::shared_ptr<Element> >& aElements ) {
+	clear();
+	mElements = aElements;
+
+	for( std::size_t i = 0; i < mElements.size(); i++ ) {
+		const string& tname = mElements[i]->name;
+		for( std::size_t glength = 1; glength <= 3; glength++ ) {
+			if( tname.size() < glength ) break;
+			for( std::size_t k = 0; k + glength <= tname.size(); k++ ) {
+				auto& posting = mPostings[ _getGramKey( tname.data() + k, glength ) ];
+				// elements are added in order, so only need to check the last one for duplicates
+				if( posting.empty() || posting.back() != i ) {
+					posting.push_back( i );
+				}
+			}
+		}
+	}
+
+	mSortedByName.resize( mElements.size() );
+	for( std::size_t i = 0; i < mElements.size(); i++ ) {
+		mSortedByName[i] = i;
+	}
+	std::stable_sort( mSortedByName.begin(), mSortedByName.end(), [this]( std::size_t a, std::size_t b ) {
+		return mElements[a]->name < mElements[b]->name;
+	});
+	mBBuilt = true;
+}
+
+//--------------------------------------------------------------
+void NameSubstringIndex::clear() {
+	mElements.clear();
+	mPostings.clear();
+	mSortedByName.clear();
+	mBBuilt = false;
+}
+
+//--------------------------------------------------------------
+void NameSubstringIndex::findContaining( const string& aStr, vector<std::size_t>& aResults ) {
+	if( aStr.empty() ) {
+		aResults.reserve( aResults.size() + mElements.size() );
+		for( std::size_t i = 0; i < mElements.size(); i++ ) {
+			aResults.push_back(i);
+		}
+		return;
+	}
+
+	if( aStr.size() <= 3 ) {
+		// the posting list for the whole string is the answer
+		auto it = mPostings.find( _getGramKey( aStr.data(), aStr.size() ));
+		if( it != mPostings.end() ) {
+			aResults.insert( aResults.end(), it->second.begin(), it->second.end() );
+		}
+		return;
+	}
+
+	// use the shortest posting list of the trigrams as the candidates and verify them
+	const vector<std::size_t>* candidates = nullptr;
+	for( std::size_t k = 0; k + 3 <= aStr.size(); k++ ) {
+		auto it = mPostings.find( _getGramKey( aStr.data() + k, 3 ));
+		if( it == mPostings.end() ) {
+			// a trigram that is not in any name
+			return;
+		}
+		if( !candidates || it->second.size() < candidates->size() ) {
+			candidates = &it->second;
+		}
+	}
+	for( auto index : *candidates ) {
+		if( mElements[index]->name.find( aStr ) != string::npos ) {
+			aResults.push_back( index );
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void NameSubstringIndex::findWithPrefix( const string& aPrefix, vector<std::size_t>& aResults ) {
+	auto it = std::lower_bound( mSortedByName.begin(), mSortedByName.end(), aPrefix, [this]( std::size_t a, const string& aprefix ) {
+		return mElements[a]->name < aprefix;
+	});
+	std::size_t startSize = aResults.size();
+	for( ; it != mSortedByName.end(); ++it ) {
+		if( mElements[*it]->name.compare( 0, aPrefix.size(), aPrefix ) != 0 ) {
+			break;
+		}
+		aResults.push_back( *it );
+	}
+	// return in the original order
+	std::sort( aResults.begin() + startSize, aResults.end() );
+}
+
+//--------------------------------------------------------------
+uint32_t NameSubstringIndex::_getGramKey( const char* aStr, std::size_t aLength ) {
+	uint32_t key = (uint32_t)aLength << 24;
+	for( std::size_t i = 0; i < aLength; i++ ) {
+		key |= (uint32_t)(unsigned char)aStr[i] << (16 - i * 8);
+	}
+	return key;
+}
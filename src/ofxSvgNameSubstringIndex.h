@@ -0,0 +1,36 @@
+//
+//  ofxSvgNameSubstringIndex.h
+//
+//  n-gram index over element names for substring and prefix queries.
+//
+
+#pragma once
+#include "ofxSvgElements.h"
+#include <unordered_map>
+
+namespace ofx::svg {
+class NameSubstringIndex {
+public:
+	void build( const std::vector< std::shared_ptr<Element> >& aElements );
+	void clear();
+	bool isBuilt() { return mBBuilt; }
+
+	// the query results are indices into the elements, in the order they were passed to build.
+	// matches ofIsStringInString( name, aStr ), case sensitive.
+	void findContaining( const std::string& aStr, std::vector<std::size_t>& aResults );
+	void findWithPrefix( const std::string& aPrefix, std::vector<std::size_t>& aResults );
+
+	const std::vector< std::shared_ptr<Element> >& getElements() { return mElements; }
+
+protected:
+	// packs grams of 1 to 3 chars into a key
+	static uint32_t _getGramKey( const char* aStr, std::size_t aLength );
+
+	bool mBBuilt = false;
+	std::vector< std::shared_ptr<Element> > mElements;
+	// gram key to the elements containing it, each list is sorted and unique
+	std::unordered_map< uint32_t, std::vector<std::size_t> > mPostings;
+	// element indices sorted by name, for prefix queries
+	std::vector<std::size_t> mSortedByName;
+};
+}
@@ -17,12 +17,21 @@ using std::shared_ptr;
 //--------------------------------------------------------------
 bool Parser::load( of::filesystem::path aPathToSvg ) {
     mChildren.clear();
+	_onChildrenChanged();
 	mDefElements.clear();
     mCurrentLayer = 0;
 	mCurrentSvgCss.reset();
 	mSvgCss.clear();
 	mCPoints.clear();
 	mCenterPoints.clear();
+	mStringTable.clear();
+	mNumVerticesBeforeSimplification = 0;
+	mNumVerticesAfterSimplification = 0;
+	// the previous arena is released once the last of its elements is destroyed
+	mArena.reset();
+	if( mBUseArena ) {
+		mArena = std::make_shared<Arena>();
+	}
     
     ofFile mainXmlFile( aPathToSvg, ofFile::ReadOnly );
     ofBuffer tMainXmlBuffer( mainXmlFile );
@@ -85,8 +94,34 @@ bool Parser::load( of::filesystem::path aPathToSvg ) {
 		
 		// the defs are added in the _parseXmlNode function //
 		_parseXmlNode( svgNode, mChildren );
+		internStrings();
+		// after the new elements requested their images, so the files shared with the previous document stay decoded
+		ImageCache::sGetShared().releaseUnused();
 		
 		ofLogVerbose(moduleName()) << " number of defs elements: " << mDefElements.size();
+		
+		_linkChildrenRecursive();
+		// the groups were filled through getChildren() while parsing, before any of their lookups were cached
+		_updateChildrenSnapshot( true );
+		if( mArena ) {
+			ofLogVerbose(moduleName()) << __FUNCTION__ << " : arena served " << mArena->getNumAllocations() << " allocations from " << mArena->getNumBlocks() << " blocks, " << mArena->getNumBytesUsed() << " of " << mArena->getNumBytesReserved() << " bytes.";
+		}
+		if( mBUseImageAtlas ) {
+			buildImageAtlas();
+		}
+		// before the levels of detail, so they are built from the simplified outlines
+		if( mBSimplifyPaths ) {
+			_simplifyPaths();
+		}
+		if( mBPathLod ) {
+			_applyPathLod();
+		}
+		if( mBUseNameIndex ) {
+			buildNameIndex();
+		}
+		if( mBUseSpatialIndex ) {
+			buildSpatialIndex();
+		}
     }
     
     return true;
@@ -184,14 +219,14 @@ void Parser::_parseXmlNode( ofXml& aParentNode, vector< shared_ptr<Element> >& a
 			auto fkid = kid.getFirstChild();
 			if( fkid ) {
 				mCurrentSvgCss.reset();
-				auto tgroup = std::make_shared<Group>();
+				auto tgroup = _makeShared<Group>();
 				tgroup->layer = mCurrentLayer += 1.0;
 				auto idattr = kid.getAttribute("id");
 				if( idattr ) {
 					tgroup->name = idattr.getValue();
 				}
 				
-				mCurrentSvgCss = std::make_shared<ofx::svg::CssClass>( _parseStyle(kid) );
+				mCurrentSvgCss = _makeShared<ofx::svg::CssClass>( _parseStyle(kid) );
 				
 				aElements.push_back( tgroup );
 				_parseXmlNode( kid, tgroup->getChildren() );
@@ -199,6 +234,8 @@ void Parser::_parseXmlNode( ofXml& aParentNode, vector< shared_ptr<Element> >& a
 		} else if( kid.getName() == "defs") {
 			ofLogVerbose(moduleName()) << __FUNCTION__ << " found a defs node.";
 			_parseXmlNode(kid, mDefElements );
+			// so the <use> nodes can find the defs by id
+			_internStringsRecursive( mDefElements );
         } else {
             
             bool bAddOk = _addElementFromXmlNode( kid, aElements );
@@ -220,32 +257,33 @@ bool Parser::_addElementFromXmlNode( ofXml& tnode, vector< shared_ptr<Element> >
 				// try to find by id
 				href = href.substr(1, std::string::npos);
 				ofLogVerbose(moduleName()) << "going to look for href " << href;
+				uint32_t hrefId = mStringTable.find( href );
 				for( auto & def : mDefElements ) {
-					if( def->name == href ) {
+					if( hrefId != StringTable::INVALID_ID && def->nameId == hrefId ) {
 						if( def->getType() == ofx::svg::TYPE_RECTANGLE ) {
 							auto drect = std::dynamic_pointer_cast<ofx::svg::Rectangle>(def);
-							auto nrect = std::make_shared<ofx::svg::Rectangle>( *drect );
+							auto nrect = _makeShared<ofx::svg::Rectangle>( *drect );
 							telement = nrect;
 						} else if( def->getType() == ofx::svg::TYPE_IMAGE ) {
 							auto dimg = std::dynamic_pointer_cast<ofx::svg::Image>(def);
-							auto nimg = std::make_shared<ofx::svg::Image>( *dimg );
+							auto nimg = _makeShared<ofx::svg::Image>( *dimg );
 							ofLogVerbose(moduleName()) << "created an image node with filepath: " << nimg->getFilePath();
 							telement = nimg;
 						} else if( def->getType() == ofx::svg::TYPE_ELLIPSE ) {
 							auto dell= std::dynamic_pointer_cast<ofx::svg::Ellipse>(def);
-							auto nell = std::make_shared<ofx::svg::Ellipse>( *dell );
+							auto nell = _makeShared<ofx::svg::Ellipse>( *dell );
 							telement = nell;
 						} else if( def->getType() == ofx::svg::TYPE_CIRCLE ) {
 							auto dcir= std::dynamic_pointer_cast<ofx::svg::Circle>(def);
-							auto ncir = std::make_shared<ofx::svg::Circle>( *dcir );
+							auto ncir = _makeShared<ofx::svg::Circle>( *dcir );
 							telement = ncir;
 						} else if( def->getType() == ofx::svg::TYPE_PATH ) {
 							auto dpat= std::dynamic_pointer_cast<ofx::svg::Path>(def);
-							auto npat = std::make_shared<ofx::svg::Path>( *dpat );
+							auto npat = _makeShared<ofx::svg::Path>( *dpat );
 							telement = npat;
 						} else if( def->getType() == ofx::svg::TYPE_TEXT ) {
 							auto dtex = std::dynamic_pointer_cast<ofx::svg::Text>(def);
-							auto ntex = std::make_shared<ofx::svg::Text>( *dtex );
+							auto ntex = _makeShared<ofx::svg::Text>( *dtex );
 							telement = ntex;
 						} else {
 							ofLogWarning("Parser") << "could not find type for def : " << def->name;
@@ -260,7 +298,7 @@ bool Parser::_addElementFromXmlNode( ofXml& tnode, vector< shared_ptr<Element> >
 			ofLogWarning(moduleName()) << "found a use node but no href!";
 		}
 	} else if( tnode.getName() == "image" ) {
-        auto image = std::make_shared<Image>();
+        auto image = _makeShared<Image>();
         auto wattr = tnode.getAttribute("width");
         if(wattr) image->width  = wattr.getFloatValue();
         auto hattr = tnode.getAttribute("height");
@@ -268,11 +306,13 @@ bool Parser::_addElementFromXmlNode( ofXml& tnode, vector< shared_ptr<Element> >
         auto xlinkAttr = tnode.getAttribute("xlink:href");
         if( xlinkAttr ) {
             image->filepath = folderPath+xlinkAttr.getValue();
+            // start decoding now, <use> copies share the cache entry
+            image->getCacheEntry( mBAsyncImageLoading );
         }
         telement = image;
         
     } else if( tnode.getName() == "ellipse" ) {
-        auto ellipse = std::make_shared<Ellipse>();
+        auto ellipse = _makeShared<Ellipse>();
         auto cxAttr = tnode.getAttribute("cx");
         if(cxAttr) ellipse->pos.x = cxAttr.getFloatValue();
         auto cyAttr = tnode.getAttribute("cy");
@@ -290,7 +330,7 @@ bool Parser::_addElementFromXmlNode( ofXml& tnode, vector< shared_ptr<Element> >
         
         telement = ellipse;
 	} else if( tnode.getName() == "circle" ) {
-		auto circle = std::make_shared<Circle>();
+		auto circle = _makeShared<Circle>();
 		auto cxAttr = tnode.getAttribute("cx");
 		if(cxAttr) circle->pos.x = cxAttr.getFloatValue();
 		auto cyAttr = tnode.getAttribute("cy");
@@ -308,7 +348,7 @@ bool Parser::_addElementFromXmlNode( ofXml& tnode, vector< shared_ptr<Element> >
 		telement = circle;
 		
 	} else if( tnode.getName() == "line" ) {
-		auto telePath = std::make_shared<Path>();
+		auto telePath = _makeShared<Path>();
 		
 		glm::vec3 p1 = {0.f, 0.f, 0.f};
 		glm::vec3 p2 = {0.f, 0.f, 0.f};
@@ -332,17 +372,17 @@ bool Parser::_addElementFromXmlNode( ofXml& tnode, vector< shared_ptr<Element> >
 		telement = telePath;
         
 	} else if(tnode.getName() == "polyline" || tnode.getName() == "polygon") {
-		auto tpath = std::make_shared<Path>();
+		auto tpath = _makeShared<Path>();
 		_parsePolylinePolygon(tnode, tpath);
 		_applyStyleToPath( tnode, tpath );
 		telement = tpath;
 	} else if( tnode.getName() == "path" ) {
-		auto tpath = std::make_shared<Path>();
+		auto tpath = _makeShared<Path>();
 		_parsePath( tnode, tpath );
 		_applyStyleToPath( tnode, tpath );
 		telement = tpath;
     } else if( tnode.getName() == "rect" ) {
-        auto rect = std::make_shared<Rectangle>();
+        auto rect = _makeShared<Rectangle>();
         auto xattr = tnode.getAttribute("x");
         if(xattr) rect->rectangle.x       = xattr.getFloatValue();
         auto yattr = tnode.getAttribute("y");
@@ -378,7 +418,7 @@ bool Parser::_addElementFromXmlNode( ofXml& tnode, vector< shared_ptr<Element> >
         }
         
     } else if( tnode.getName() == "text" ) {
-        auto text = std::make_shared<Text>();
+        auto text = _makeShared<Text>();
         telement = text;
 //		std::cout << "has kids: " << tnode.getFirstChild() << " node value: " << tnode.getValue() << std::endl;
         if( tnode.getFirstChild() ) {
@@ -475,7 +515,12 @@ bool Parser::_addElementFromXmlNode( ofXml& tnode, vector< shared_ptr<Element> >
     if( telement->getType() == TYPE_TEXT ) {
         auto text = std::dynamic_pointer_cast<Text>( telement );
         text->ogPos = text->pos;
-        text->create();
+        text->bUseSdfFont = mBUseSdfText;
+        if( mBMeasureDeferredText && mBDeferTextCreation ) {
+            text->measure();
+        } else if( !mBDeferTextCreation ) {
+            text->create();
+        }
     }
 	
 	_applyStyleToElement(tnode, telement);
@@ -1136,6 +1181,16 @@ CssClass Parser::_parseStyle( ofXml& anode ) {
 		css.addProperty("stroke-width", strokeWidthAttr.getValue());
 	}
 	
+	for( auto& tname : { "stroke-linejoin", "stroke-linecap", "stroke-miterlimit" } ) {
+		if( auto strokeStyleAttr = anode.getAttribute(tname)) {
+			css.addProperty(tname, strokeStyleAttr.getValue());
+		}
+	}
+	
+	if( auto fillRuleAttr = anode.getAttribute("fill-rule")) {
+		css.addProperty("fill-rule", fillRuleAttr.getValue());
+	}
+	
 	if( auto ffattr = anode.getAttribute("font-family") ) {
 		std::string tFontFam = ffattr.getValue();
 		ofStringReplace( tFontFam, "'", "" );
@@ -1211,6 +1266,24 @@ void Parser::_applyStyleToPath( CssClass& aclass, std::shared_ptr<Path> aSvgPath
 			aSvgPath->path.setStrokeWidth(1.f);
 		}
 	}
+	
+	if( aclass.hasProperty("stroke-linejoin") || aclass.hasProperty("stroke-linecap") || aclass.hasProperty("stroke-miterlimit")) {
+		auto tstyle = aSvgPath->getStrokeStyle();
+		tstyle.setLineJoin( aclass.getValue("stroke-linejoin", "miter"));
+		tstyle.setLineCap( aclass.getValue("stroke-linecap", "butt"));
+		tstyle.miterLimit = std::max( 1.f, aclass.getFloatValue("stroke-miterlimit", 4.f));
+		aSvgPath->setStrokeStyle( tstyle );
+	}
+	aSvgPath->setStrokeTessellationEnabled( mBTessellateStrokes );
+	
+	if( aclass.hasProperty("fill-rule")) {
+		auto fillRule = aclass.getValue("fill-rule", "nonzero");
+		if( fillRule == "evenodd" ) {
+			aSvgPath->path.setPolyWindingMode(OF_POLY_WINDING_ODD);
+		} else if( fillRule == "nonzero" ) {
+			aSvgPath->path.setPolyWindingMode(OF_POLY_WINDING_NONZERO);
+		}
+	}
 }
 
 //--------------------------------------------------------------
@@ -1374,7 +1447,7 @@ bool Parser::getTransformFromSvgMatrix( string aStr, glm::vec2& apos, float& sca
 
 //--------------------------------------------------------------
 std::shared_ptr<Text::TextSpan> Parser::getTextSpanFromXmlNode( ofXml& anode ) {
-	auto tspan = std::make_shared<Text::TextSpan>();;
+	auto tspan = _makeShared<Text::TextSpan>();;
     
     string tText = anode.getValue();
     float tx = 0;
@@ -1397,6 +1470,352 @@ std::shared_ptr<Text::TextSpan> Parser::getTextSpanFromXmlNode( ofXml& anode ) {
     return tspan;
 }
 
+//--------------------------------------------------------------
+void Parser::setSpatialIndexEnabled( bool ab ) {
+	mBUseSpatialIndex = ab;
+	if( !mBUseSpatialIndex ) {
+		mSpatialIndex.clear();
+		mBSpatialIndexDirty = true;
+	}
+}
+
+//--------------------------------------------------------------
+void Parser::buildSpatialIndex() {
+	_syncChildren();
+	_linkChildrenRecursive();
+	mSpatialIndex.build( *this );
+	mBSpatialIndexDirty = false;
+}
+
+//--------------------------------------------------------------
+SpatialIndex& Parser::getSpatialIndex() {
+	_syncChildren();
+	if( mBSpatialIndexDirty ) {
+		buildSpatialIndex();
+	}
+	return mSpatialIndex;
+}
+
+//--------------------------------------------------------------
+CompactDocument& Parser::getCompactDocument() {
+	_syncChildren();
+	if( mBCompactDocumentDirty ) {
+		_linkChildrenRecursive();
+		mCompactDocument.build( *this );
+		mBCompactDocumentDirty = false;
+	}
+	return mCompactDocument;
+}
+
+//--------------------------------------------------------------
+void Parser::invalidateCompactDocument() {
+	mCompactDocument.clear();
+	mBCompactDocumentDirty = true;
+}
+
+//--------------------------------------------------------------
+bool Parser::updateSpatialIndex( std::shared_ptr<Element> aElement ) {
+	if( aElement ) {
+		aElement->invalidateBounds();
+	}
+	_syncChildren();
+	if( mBSpatialIndexDirty ) {
+		// will pick up the change when it is rebuilt
+		return false;
+	}
+	return mSpatialIndex.update( aElement );
+}
+
+//--------------------------------------------------------------
+vector< shared_ptr<Element> > Parser::queryRect( const ofRectangle& aRect ) {
+	return getSpatialIndex().queryRect( aRect );
+}
+
+//--------------------------------------------------------------
+vector< shared_ptr<Element> > Parser::queryPoint( const glm::vec2& aPoint ) {
+	return getSpatialIndex().queryPoint( aPoint );
+}
+
+//--------------------------------------------------------------
+shared_ptr<Element> Parser::nearest( const glm::vec2& aPoint, float aMaxDistance ) {
+	return getSpatialIndex().nearest( aPoint, aMaxDistance );
+}
+
+//--------------------------------------------------------------
+void Parser::setArenaAllocationEnabled( bool ab ) {
+	mBUseArena = ab;
+}
+
+//--------------------------------------------------------------
+MemoryStats Parser::getMemoryStats( std::size_t aNumHeaviest ) {
+	MemoryStats tstats;
+	tstats.usage.elements += sizeof(Parser) + MemoryUsage::sGetNumBytes( mChildren ) + MemoryUsage::sGetNumBytes( mDefElements );
+	tstats.usage.strings += MemoryUsage::sGetNumBytes( svgPath ) + MemoryUsage::sGetNumBytes( folderPath ) + MemoryUsage::sGetNumBytes( fontsDirectory );
+	tstats.addElements( mChildren );
+	// not drawn, but kept for the <use> nodes
+	tstats.addElements( mDefElements );
+	tstats.addStyleSheet( mSvgCss );
+	if( mCurrentSvgCss ) {
+		tstats.usage.styles += MemoryUsage::sGetNumBytes( *mCurrentSvgCss );
+	}
+	tstats.usage.strings += mStringTable.getNumBytes();
+	tstats.finish( aNumHeaviest );
+	return tstats;
+}
+
+//--------------------------------------------------------------
+void Parser::internStrings() {
+	_internStringsRecursive( mChildren );
+	_internStringsRecursive( mDefElements );
+	for( auto& tit : mSvgCss.classes ) {
+		tit.second.nameId = mStringTable.intern( tit.second.name );
+	}
+	ofLogVerbose(moduleName()) << __FUNCTION__ << " : " << mStringTable.getNumReferences() << " strings interned as " << mStringTable.size() << " unique strings.";
+}
+
+//--------------------------------------------------------------
+void Parser::_internStringsRecursive( const vector< shared_ptr<Element> >& aElements ) {
+	for( auto& ele : aElements ) {
+		if( !ele ) continue;
+		ele->nameId = mStringTable.intern( ele->name );
+		if( ele->getType() == TYPE_TEXT ) {
+			auto ttext = std::static_pointer_cast<Text>( ele );
+			for( auto& tspan : ttext->textSpans ) {
+				if( tspan ) {
+					tspan->fontFamilyId = mStringTable.intern( tspan->fontFamily );
+				}
+			}
+		} else if( ele->isGroup() ) {
+			// the const children, so the cached lookups of the group are not invalidated
+			const Group& tgroup = *std::static_pointer_cast<Group>( ele );
+			_internStringsRecursive( tgroup.getChildren() );
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void Parser::setDeferTextCreation( bool ab ) {
+	mBDeferTextCreation = ab;
+}
+
+//--------------------------------------------------------------
+void Parser::setMeasureDeferredText( bool ab ) {
+	mBMeasureDeferredText = ab;
+}
+
+//--------------------------------------------------------------
+void Parser::setSdfTextEnabled( bool ab ) {
+	mBUseSdfText = ab;
+}
+
+//--------------------------------------------------------------
+void Parser::setAsyncImageLoading( bool ab ) {
+	mBAsyncImageLoading = ab;
+}
+
+//--------------------------------------------------------------
+void Parser::waitForImages() {
+	ImageCache::sGetShared().waitForAll();
+}
+
+//--------------------------------------------------------------
+void Parser::setImageAtlasEnabled( bool ab, int aMaxImageSize, int aPageSize ) {
+	mBUseImageAtlas = ab;
+	mImageAtlasMaxImageSize = aMaxImageSize;
+	mImageAtlas.setup( aPageSize );
+}
+
+//--------------------------------------------------------------
+void Parser::buildImageAtlas() {
+	mImageAtlas.clear();
+	waitForImages();
+	
+	// images sharing a file are packed once
+	std::map< ImageCache::Entry*, vector<Image*> > imagesForEntry;
+	for( auto image : getAllElementsForTypeView<Image>() ) {
+		image->atlasPage.reset();
+		auto tentry = image->getCacheEntry();
+		if( tentry->isFailed() ) continue;
+		auto& tpix = tentry->getPixels();
+		if( (int)tpix.getWidth() > mImageAtlasMaxImageSize || (int)tpix.getHeight() > mImageAtlasMaxImageSize ) {
+			continue;
+		}
+		imagesForEntry[ tentry.get() ].push_back( image );
+	}
+	
+	vector< ImageCache::Entry* > entries;
+	entries.reserve( imagesForEntry.size() );
+	for( auto& it : imagesForEntry ) {
+		entries.push_back( it.first );
+	}
+	// tallest first packs the shelves tighter
+	std::sort( entries.begin(), entries.end(), []( ImageCache::Entry* a, ImageCache::Entry* b ) {
+		return a->getPixels().getHeight() > b->getPixels().getHeight();
+	});
+	
+	for( auto tentry : entries ) {
+		shared_ptr<TextureAtlas::Page> tpage;
+		ofRectangle trect;
+		if( mImageAtlas.add( tentry->getPixels(), tpage, trect )) {
+			for( auto image : imagesForEntry[tentry] ) {
+				image->atlasPage = tpage;
+				image->atlasRect = trect;
+			}
+		}
+	}
+	ofLogVerbose(moduleName()) << __FUNCTION__ << " : packed " << entries.size() << " images into " << mImageAtlas.getPages().size() << " pages.";
+	
+	// the texture keys of the images have changed
+	invalidateBatchRenderer();
+}
+
+//--------------------------------------------------------------
+void Parser::draw() {
+	if( mBUseBatchRenderer ) {
+		getBatchRenderer().draw();
+	} else if( mBUseInstancedRenderer ) {
+		getInstancedRenderer().draw();
+	} else {
+		Group::draw();
+	}
+}
+
+//--------------------------------------------------------------
+void Parser::setBatchRenderingEnabled( bool ab ) {
+	mBUseBatchRenderer = ab;
+	if( !mBUseBatchRenderer ) {
+		mBatchRenderer.clear();
+		mBBatchRendererDirty = true;
+	}
+}
+
+//--------------------------------------------------------------
+BatchRenderer& Parser::getBatchRenderer() {
+	_syncChildren();
+	if( mBBatchRendererDirty ) {
+		_linkChildrenRecursive();
+		mBatchRenderer.build( *this );
+		mBBatchRendererDirty = false;
+	}
+	return mBatchRenderer;
+}
+
+//--------------------------------------------------------------
+bool Parser::markBatchDirty( std::shared_ptr<Element> aElement ) {
+	_syncChildren();
+	if( mBBatchRendererDirty ) {
+		// will pick up the change when it is rebuilt
+		return false;
+	}
+	return mBatchRenderer.markDirty( aElement );
+}
+
+//--------------------------------------------------------------
+void Parser::invalidateBatchRenderer() {
+	mBatchRenderer.clear();
+	mBBatchRendererDirty = true;
+}
+
+//--------------------------------------------------------------
+void Parser::setInstancedRenderingEnabled( bool ab ) {
+	mBUseInstancedRenderer = ab;
+	if( !mBUseInstancedRenderer ) {
+		invalidateInstancedRenderer();
+	}
+}
+
+//--------------------------------------------------------------
+InstancedRenderer& Parser::getInstancedRenderer() {
+	_syncChildren();
+	if( mBInstancedRendererDirty ) {
+		_linkChildrenRecursive();
+		mInstancedRenderer.build( *this );
+		mBInstancedRendererDirty = false;
+	}
+	return mInstancedRenderer;
+}
+
+//--------------------------------------------------------------
+void Parser::invalidateInstancedRenderer() {
+	mInstancedRenderer.clear();
+	mBInstancedRendererDirty = true;
+}
+
+//--------------------------------------------------------------
+void Parser::_onChildrenChanged() {
+	Group::_onChildrenChanged();
+	mSpatialIndex.clear();
+	mBSpatialIndexDirty = true;
+	invalidateBatchRenderer();
+	invalidateInstancedRenderer();
+	invalidateCompactDocument();
+}
+
+//--------------------------------------------------------------
+void Parser::setPathLodEnabled( bool ab, int aNumLevels, float aBaseTolerance ) {
+	mBPathLod = ab;
+	mPathLodLevels = aNumLevels;
+	mPathLodTolerance = aBaseTolerance;
+	_applyPathLod();
+}
+
+//--------------------------------------------------------------
+void Parser::setPathSimplificationEnabled( bool ab, float aTolerance ) {
+	mBSimplifyPaths = ab;
+	mSimplifyTolerance = std::max( 0.f, aTolerance );
+}
+
+//--------------------------------------------------------------
+void Parser::_simplifyPaths() {
+	mNumVerticesBeforeSimplification = 0;
+	mNumVerticesAfterSimplification = 0;
+	for( auto tpath : getAllElementsForTypeView<Path>() ) {
+		mNumVerticesBeforeSimplification += tpath->getNumVerticesForLod(0);
+		tpath->simplify( mSimplifyTolerance );
+		mNumVerticesAfterSimplification += tpath->getNumVerticesForLod(0);
+	}
+	ofLogVerbose(moduleName()) << __FUNCTION__ << " : simplified paths from " << mNumVerticesBeforeSimplification << " to " << mNumVerticesAfterSimplification << " vertices.";
+}
+
+//--------------------------------------------------------------
+void Parser::_applyPathLod() {
+	auto applyToType = [this]( auto aView ) {
+		for( auto tpath : aView ) {
+			tpath->setLodEnabled( mBPathLod, mPathLodLevels, mPathLodTolerance );
+		}
+	};
+	applyToType( getAllElementsForTypeView<Path>() );
+	applyToType( getAllElementsForTypeView<Rectangle>() );
+	applyToType( getAllElementsForTypeView<Circle>() );
+	applyToType( getAllElementsForTypeView<Ellipse>() );
+}
+
+//--------------------------------------------------------------
+void Parser::setStrokeTessellationEnabled( bool ab ) {
+	mBTessellateStrokes = ab;
+	auto applyToType = [this]( auto aView ) {
+		for( auto tpath : aView ) {
+			tpath->setStrokeTessellationEnabled( mBTessellateStrokes );
+		}
+	};
+	applyToType( getAllElementsForTypeView<Path>() );
+	applyToType( getAllElementsForTypeView<Rectangle>() );
+	applyToType( getAllElementsForTypeView<Circle>() );
+	applyToType( getAllElementsForTypeView<Ellipse>() );
+	// the strokes are batched as triangles instead of lines
+	invalidateBatchRenderer();
+	invalidateInstancedRenderer();
+}
+
+//--------------------------------------------------------------
+bool Parser::renderToPixels( ofPixels& aPixels, int aWidth, int aHeight ) {
+	ofRectangle tview = viewbox;
+	if( tview.width <= 0.f || tview.height <= 0.f ) {
+		tview = bounds;
+	}
+	return mSoftwareRenderer.render( *this, tview, aWidth, aHeight, aPixels );
+}
+
 //--------------------------------------------------------------
 const ofRectangle Parser::getBounds(){
 	return bounds;
@@ -8,30 +8,204 @@
 #include "ofxSvgGroup.h"
 #include "ofXml.h"
 #include "ofxSvgCss.h"
+#include "ofxSvgSpatialIndex.h"
+#include "ofxSvgBatchRenderer.h"
+#include "ofxSvgInstancedRenderer.h"
+#include "ofxSvgCompactDocument.h"
+#include "ofxSvgArena.h"
+#include "ofxSvgStringTable.h"
+#include "ofxSvgMemoryStats.h"
+#include "ofxSvgSoftwareRenderer.h"
 
 namespace ofx::svg {
 class Parser : public Group {
 public:
 	
-	virtual SvgType getType() override {return TYPE_DOCUMENT;}
+	static SvgType sGetType() {return TYPE_DOCUMENT;}
+	virtual SvgType getType() override {return sGetType();}
 	
 	bool load( of::filesystem::path aPathToSvg );
 	bool reload();
 	
+	// allocates the elements, text spans and styles of the next load from one arena in large blocks instead of
+	// one heap allocation each. The blocks are released together once the last element of the document is destroyed.
+	void setArenaAllocationEnabled( bool ab );
+	bool isArenaAllocationEnabled() { return mBUseArena; }
+	// nullptr unless the document was loaded with arena allocation enabled
+	std::shared_ptr<Arena> getArena() { return mArena; }
+	
+	// element names, font families and css class names of the document, interned while loading.
+	// Compare Element::nameId and TextSpan::fontFamilyId instead of the strings, ie.
+	// svg.getAllElementsForNameId( svg.getStringTable().find( "No Name" ));
+	StringTable& getStringTable() { return mStringTable; }
+	// interns the names again, call after renaming elements or adding elements that were not loaded
+	void internStrings();
+	
+	// approximate bytes held by the document by category and element type, with the aNumHeaviest heaviest elements.
+	// Images shared with other documents through the ImageCache are counted in full, the fonts shared by all of
+	// the documents and the caches of the renderers and indices are not counted.
+	MemoryStats getMemoryStats( std::size_t aNumHeaviest = 10 );
+	
+	// only records the text spans while loading, without loading fonts or building meshes.
+	// Each Text is created on its first draw or by calling Text::create(), until then the span sizes are not measured, see setMeasureDeferredText.
+	void setDeferTextCreation( bool ab );
+	bool isDeferTextCreation() { return mBDeferTextCreation; }
+	// measures the deferred text with FreeType while loading, see Text::measure,
+	// so the text bounds are available in headless processes
+	void setMeasureDeferredText( bool ab );
+	bool isMeasureDeferredText() { return mBMeasureDeferredText; }
+	
+	// draws the text from one signed distance field atlas per font family instead of a font and texture per size.
+	// Glyphs are added to the atlas as they are used. Set before loading.
+	void setSdfTextEnabled( bool ab );
+	bool isSdfTextEnabled() { return mBUseSdfText; }
+	
+	// images are decoded on worker threads while loading and drawn once they are ready.
+	// When disabled they are decoded on the calling thread during load.
+	void setAsyncImageLoading( bool ab );
+	bool isAsyncImageLoading() { return mBAsyncImageLoading; }
+	// blocks until all of the requested images have been decoded
+	void waitForImages();
+	
+	// packs the images that are at most aMaxImageSize pixels on each side into shared texture pages after loading,
+	// so they can be drawn with a single bind by the batch renderer. Waits for the images to be decoded.
+	void setImageAtlasEnabled( bool ab, int aMaxImageSize = 256, int aPageSize = 2048 );
+	bool isImageAtlasEnabled() { return mBUseImageAtlas; }
+	void buildImageAtlas();
+	TextureAtlas& getImageAtlas() { return mImageAtlas; }
+	
+	// simplifies the outlines of the paths while loading, merging nearly collinear segments and removing the points
+	// that are within aTolerance document units of the outline, see Path::simplify. Curves are flattened.
+	// Rectangles, circles and ellipses are left as they are. Set before loading.
+	void setPathSimplificationEnabled( bool ab, float aTolerance = 0.25f );
+	bool isPathSimplificationEnabled() { return mBSimplifyPaths; }
+	// vertices of the flattened paths of the last load, before and after simplifying them
+	std::size_t getNumVerticesBeforeSimplification() { return mNumVerticesBeforeSimplification; }
+	std::size_t getNumVerticesAfterSimplification() { return mNumVerticesAfterSimplification; }
+	
+	// draws simplified outlines for paths that cover few pixels on screen, see Path::setLodEnabled.
+	// Applies to the loaded paths and to the paths of documents loaded afterwards.
+	void setPathLodEnabled( bool ab, int aNumLevels = 4, float aBaseTolerance = 0.5f );
+	bool isPathLodEnabled() { return mBPathLod; }
+	
+	// draws the strokes as triangles tessellated on the cpu, honoring the stroke width, stroke-linejoin,
+	// stroke-linecap and stroke-miterlimit. The triangles are cached per path, see Path::getStrokeMesh.
+	void setStrokeTessellationEnabled( bool ab );
+	bool isStrokeTessellationEnabled() { return mBTessellateStrokes; }
+	
+	// renders the viewbox into aPixels on the cpu, without a gl context, see SoftwareRenderer
+	bool renderToPixels( ofPixels& aPixels, int aWidth, int aHeight );
+	SoftwareRenderer& getSoftwareRenderer() { return mSoftwareRenderer; }
+	
 	void setFontsDirectory( std::string aDir );
 	
 	std::string toString(int nlevel = 0) override;
 	
 	bool getTransformFromSvgMatrix( std::string aStr, glm::vec2& apos, float& scaleX, float& scaleY, float& arotation );
 	
+	// x, y, width and height of the svg element, getLocalBounds() covers the geometry
 	const ofRectangle getBounds();
 	const ofRectangle getViewbox();
 	
 	const int getTotalLayers();
 	
+	// draws the batches when batch rendering is enabled, otherwise each element is drawn
+	virtual void draw() override;
+	using Group::draw;
 	virtual void drawDebug();
 	
+	// retained mode rendering, merges the document into a few vbo meshes on the first draw.
+	// Call markBatchDirty() after changing the geometry, colors or visibility of an element and
+	// invalidateBatchRenderer() after changing the fill, stroke or texture or moving elements around.
+	void setBatchRenderingEnabled( bool ab );
+	bool isBatchRenderingEnabled() { return mBUseBatchRenderer; }
+	BatchRenderer& getBatchRenderer();
+	bool markBatchDirty( std::shared_ptr<Element> aElement );
+	void invalidateBatchRenderer();
+	
+	// draws paths with the same shape, like the copies from <use> elements, with one instanced draw call
+	// when batch rendering is disabled, see InstancedRenderer. Call getInstancedRenderer().markDirty()
+	// after changing colors or visibility and invalidateInstancedRenderer() after changing shapes.
+	void setInstancedRenderingEnabled( bool ab );
+	bool isInstancedRenderingEnabled() { return mBUseInstancedRenderer; }
+	InstancedRenderer& getInstancedRenderer();
+	void invalidateInstancedRenderer();
+	
+	// optional bounding volume hierarchy over the document space bounds of the elements.
+	// Built after load and rebuilt lazily when the hierarchy changes.
+	void setSpatialIndexEnabled( bool ab );
+	bool isSpatialIndexEnabled() { return mBUseSpatialIndex; }
+	void buildSpatialIndex();
+	SpatialIndex& getSpatialIndex();
+	// call after moving an element or changing its geometry
+	bool updateSpatialIndex( std::shared_ptr<Element> aElement );
+	
+	std::vector< std::shared_ptr<Element> > queryRect( const ofRectangle& aRect );
+	std::vector< std::shared_ptr<Element> > queryPoint( const glm::vec2& aPoint );
+	std::shared_ptr<Element> nearest( const glm::vec2& aPoint, float aMaxDistance = std::numeric_limits<float>::max() );
+	
+	// flattened copy of the hierarchy with the positions, visibility and bounds in parallel arrays,
+	// for linear transform, culling and query passes over large documents. Built on the first call
+	// and again after the hierarchy changes, see CompactDocument.
+	CompactDocument& getCompactDocument();
+	void invalidateCompactDocument();
+	
 protected:
+	virtual void _onChildrenChanged() override;
+	
+	// uses the arena for the document being loaded when set
+	template<typename T, typename... Args>
+	std::shared_ptr<T> _makeShared( Args&&... aArgs ) {
+		if( mArena ) {
+			return mArena->makeShared<T>( std::forward<Args>(aArgs)... );
+		}
+		return std::make_shared<T>( std::forward<Args>(aArgs)... );
+	}
+	bool mBUseArena = false;
+	std::shared_ptr<Arena> mArena;
+	
+	void _internStringsRecursive( const std::vector< std::shared_ptr<Element> >& aElements );
+	StringTable mStringTable;
+	
+	bool mBDeferTextCreation = false;
+	bool mBMeasureDeferredText = false;
+	bool mBUseSdfText = false;
+	bool mBAsyncImageLoading = true;
+	
+	bool mBUseImageAtlas = false;
+	int mImageAtlasMaxImageSize = 256;
+	TextureAtlas mImageAtlas;
+	
+	SoftwareRenderer mSoftwareRenderer;
+	
+	bool mBTessellateStrokes = false;
+	
+	void _simplifyPaths();
+	bool mBSimplifyPaths = false;
+	float mSimplifyTolerance = 0.25f;
+	std::size_t mNumVerticesBeforeSimplification = 0;
+	std::size_t mNumVerticesAfterSimplification = 0;
+	
+	void _applyPathLod();
+	bool mBPathLod = false;
+	int mPathLodLevels = 4;
+	float mPathLodTolerance = 0.5f;
+	
+	bool mBUseBatchRenderer = false;
+	bool mBBatchRendererDirty = true;
+	BatchRenderer mBatchRenderer;
+	
+	bool mBUseInstancedRenderer = false;
+	bool mBInstancedRendererDirty = true;
+	InstancedRenderer mInstancedRenderer;
+	
+	bool mBCompactDocumentDirty = true;
+	CompactDocument mCompactDocument;
+	
+	bool mBUseSpatialIndex = false;
+	bool mBSpatialIndexDirty = true;
+	SpatialIndex mSpatialIndex;
+	
 	std::string fontsDirectory = "";
 	std::string folderPath, svgPath;
 	ofRectangle viewbox;
@@ -0,0 +1,304 @@
+//
+//  ofxSvgSdfFontAtlas.cpp
+//
+
+#include "ofxSvgSdfFontAtlas.h"
+#include "ofGraphics.h"
+#include "ofUtils.h"
+#include "ofMath.h"
+#include "ofLog.h"
+#include <cmath>
+
+using namespace ofx::svg;
+using std::string;
+using std::vector;
+
+static const string sSdfVertexShaderGL3 = R"(#version 150
+uniform mat4 modelViewProjectionMatrix;
+uniform vec4 globalColor;
+uniform float useVertexColors;
+in vec4 position;
+in vec4 color;
+in vec2 texcoord;
+out vec2 vTexCoord;
+out vec4 vColor;
+void main() {
+	vTexCoord = texcoord;
+	vColor = mix( globalColor, color, useVertexColors );
+	gl_Position = modelViewProjectionMatrix * position;
+}
+)";
+
+static const string sSdfFragmentShaderGL3 = R"(#version 150
+uniform sampler2D src_tex_unit0;
+in vec2 vTexCoord;
+in vec4 vColor;
+out vec4 fragColor;
+void main() {
+	float d = texture( src_tex_unit0, vTexCoord ).r;
+	float w = max( fwidth( d ) * 0.7, 0.0001 );
+	fragColor = vec4( vColor.rgb, vColor.a * smoothstep( 0.5 - w, 0.5 + w, d ));
+}
+)";
+
+static const string sSdfVertexShaderGL2 = R"(#version 120
+varying vec2 vTexCoord;
+varying vec4 vColor;
+void main() {
+	vTexCoord = gl_MultiTexCoord0.xy;
+	vColor = gl_Color;
+	gl_Position = ftransform();
+}
+)";
+
+static const string sSdfFragmentShaderGL2 = R"(#version 120
+uniform sampler2D src_tex_unit0;
+varying vec2 vTexCoord;
+varying vec4 vColor;
+void main() {
+	float d = texture2D( src_tex_unit0, vTexCoord ).r;
+	float w = max( fwidth( d ) * 0.7, 0.0001 );
+	gl_FragColor = vec4( vColor.rgb, vColor.a * smoothstep( 0.5 - w, 0.5 + w, d ));
+}
+)";
+
+//--------------------------------------------------------------
+bool SdfFontAtlas::setup( const string& aFontPath, int aBaseSize, int aSpread, int aPageSize ) {
+	mGlyphs.clear();
+	mShelfX = mShelfY = mShelfHeight = 0;
+	mBFull = false;
+	mBTextureDirty = true;
+
+	mFontPath = aFontPath;
+	mBaseSize = std::max( 1, aBaseSize );
+	mSpread = std::max( 1, aSpread );
+	mPageSize = std::max( 64, aPageSize );
+	mFace = FontMetrics::sGetShared().get( mFontPath, mBaseSize );
+	if( !mFace ) {
+		ofLogError(moduleName()) << __FUNCTION__ << " : unable to load " << aFontPath;
+		return false;
+	}
+	mPixels.allocate( mPageSize, mPageSize, OF_IMAGE_GRAYSCALE );
+	mPixels.set( 0 );
+	return true;
+}
+
+//--------------------------------------------------------------
+void SdfFontAtlas::addStringMesh( const string& aUtf8String, float x, float y, float aFontSize, ofMesh& aMesh ) {
+	if( !mFace || aUtf8String.empty() ) {
+		return;
+	}
+	float tscale = aFontSize / (float)mBaseSize;
+	float tpageSize = (float)mPageSize;
+	float penX = x;
+	float penY = y;
+	unsigned int prevIndex = 0;
+	for( auto c : ofUTF8Iterator( aUtf8String )) {
+		if( c == '\n' ) {
+			penX = x;
+			penY += mFace->getLineHeight() * tscale;
+			prevIndex = 0;
+			continue;
+		}
+		const Glyph* tglyph = _getGlyph( c == '\t' ? ' ' : c );
+		if( !tglyph ) {
+			prevIndex = 0;
+			continue;
+		}
+		if( c == '\t' ) {
+			// same as ofTrueTypeFont
+			penX += tglyph->advance * tscale * 4.f;
+			prevIndex = 0;
+			continue;
+		}
+		penX += mFace->getKerning( prevIndex, tglyph->index ) * tscale;
+
+		if( tglyph->rect.width > 0.f ) {
+			float x0 = penX + tglyph->left * tscale;
+			float y0 = penY - tglyph->top * tscale;
+			float x1 = x0 + tglyph->width * tscale;
+			float y1 = y0 + tglyph->height * tscale;
+			float u0 = tglyph->rect.x / tpageSize;
+			float v0 = tglyph->rect.y / tpageSize;
+			float u1 = tglyph->rect.getRight() / tpageSize;
+			float v1 = tglyph->rect.getBottom() / tpageSize;
+
+			auto tindex = (ofIndexType)aMesh.getNumVertices();
+			aMesh.addVertex( glm::vec3( x0, y0, 0.f ));
+			aMesh.addVertex( glm::vec3( x1, y0, 0.f ));
+			aMesh.addVertex( glm::vec3( x1, y1, 0.f ));
+			aMesh.addVertex( glm::vec3( x0, y1, 0.f ));
+			aMesh.addTexCoord( glm::vec2( u0, v0 ));
+			aMesh.addTexCoord( glm::vec2( u1, v0 ));
+			aMesh.addTexCoord( glm::vec2( u1, v1 ));
+			aMesh.addTexCoord( glm::vec2( u0, v1 ));
+			aMesh.addIndex( tindex );
+			aMesh.addIndex( tindex + 1 );
+			aMesh.addIndex( tindex + 2 );
+			aMesh.addIndex( tindex );
+			aMesh.addIndex( tindex + 2 );
+			aMesh.addIndex( tindex + 3 );
+		}
+		penX += tglyph->advance * tscale;
+		prevIndex = tglyph->index;
+	}
+}
+
+//--------------------------------------------------------------
+float SdfFontAtlas::getStringWidth( const string& aUtf8String, float aFontSize ) {
+	if( !mFace ) {
+		return 0.f;
+	}
+	return mFace->getStringWidth( aUtf8String ) * ( aFontSize / (float)mBaseSize );
+}
+
+//--------------------------------------------------------------
+ofTexture& SdfFontAtlas::getTexture() {
+	if( mBTextureDirty && mFace ) {
+		if( !mTexture.isAllocated() ) {
+			// normalized coordinates, the meshes do not depend on the texture target
+			mTexture.allocate( mPixels, false );
+			mTexture.setTextureMinMagFilter( GL_LINEAR, GL_LINEAR );
+		}
+		mTexture.loadData( mPixels );
+		mBTextureDirty = false;
+	}
+	return mTexture;
+}
+
+//--------------------------------------------------------------
+void SdfFontAtlas::begin( bool abVertexColors ) {
+	auto& tshader = _getShader();
+	tshader.begin();
+	tshader.setUniformTexture( "src_tex_unit0", getTexture(), 0 );
+	tshader.setUniform1f( "useVertexColors", abVertexColors ? 1.f : 0.f );
+}
+
+//--------------------------------------------------------------
+void SdfFontAtlas::end() {
+	_getShader().end();
+}
+
+//--------------------------------------------------------------
+ofShader& SdfFontAtlas::_getShader() {
+	static ofShader sShader;
+	static bool sBLoaded = false;
+	if( !sBLoaded ) {
+		sBLoaded = true;
+		bool bProgrammable = ofIsGLProgrammableRenderer();
+		sShader.setupShaderFromSource( GL_VERTEX_SHADER, bProgrammable ? sSdfVertexShaderGL3 : sSdfVertexShaderGL2 );
+		sShader.setupShaderFromSource( GL_FRAGMENT_SHADER, bProgrammable ? sSdfFragmentShaderGL3 : sSdfFragmentShaderGL2 );
+		if( bProgrammable ) {
+			sShader.bindDefaults();
+		}
+		if( !sShader.linkProgram() ) {
+			ofLogError(moduleName()) << __FUNCTION__ << " : unable to link the sdf shader";
+		}
+	}
+	return sShader;
+}
+
+//--------------------------------------------------------------
+const SdfFontAtlas::Glyph* SdfFontAtlas::_getGlyph( uint32_t aCodepoint ) {
+	auto it = mGlyphs.find( aCodepoint );
+	if( it != mGlyphs.end() ) {
+		return &it->second;
+	}
+
+	auto tmetrics = mFace->getGlyph( aCodepoint );
+	Glyph tglyph;
+	tglyph.advance = tmetrics.advance;
+	tglyph.index = tmetrics.index;
+
+	vector<unsigned char> tcoverage;
+	int tw = 0, th = 0, tleft = 0, ttop = 0;
+	if( mFace->renderGlyph( aCodepoint, tcoverage, tw, th, tleft, ttop )) {
+		int fw = tw + mSpread * 2;
+		int fh = th + mSpread * 2;
+		int px = 0, py = 0;
+		if( _addToPage( fw, fh, px, py )) {
+			std::size_t tstride = (std::size_t)mPageSize;
+			unsigned char* tdst = mPixels.getData();
+			if( tdst ) {
+				sComputeField( tcoverage.data(), tw, th, mSpread, tdst + (std::size_t)py * tstride + px, tstride );
+			}
+			tglyph.rect.set( px, py, fw, fh );
+			tglyph.left = (float)(tleft - mSpread);
+			tglyph.top = (float)(ttop + mSpread);
+			tglyph.width = (float)fw;
+			tglyph.height = (float)fh;
+			mBTextureDirty = true;
+		} else {
+			// the glyph still advances the pen, it is just not drawn
+			if( !mBFull ) {
+				ofLogWarning(moduleName()) << __FUNCTION__ << " : page of " << mPageSize << " is full for " << mFontPath;
+			}
+			mBFull = true;
+		}
+	}
+	return &mGlyphs.emplace( aCodepoint, tglyph ).first->second;
+}
+
+//--------------------------------------------------------------
+bool SdfFontAtlas::_addToPage( int aWidth, int aHeight, int& aX, int& aY ) {
+	// one pixel between the glyphs so linear filtering does not pick up the neighbours
+	int pw = aWidth + 1;
+	int ph = aHeight + 1;
+	if( pw > mPageSize || ph > mPageSize ) {
+		return false;
+	}
+	if( mShelfX + pw > mPageSize ) {
+		mShelfY += mShelfHeight;
+		mShelfX = 0;
+		mShelfHeight = 0;
+	}
+	if( mShelfY + ph > mPageSize ) {
+		return false;
+	}
+	aX = mShelfX;
+	aY = mShelfY;
+	mShelfX += pw;
+	mShelfHeight = std::max( mShelfHeight, ph );
+	return true;
+}
+
+//--------------------------------------------------------------
+void SdfFontAtlas::sComputeField( const unsigned char* aCoverage, int aWidth, int aHeight, int aSpread, unsigned char* aOut, std::size_t aOutStride ) {
+	int fw = aWidth + aSpread * 2;
+	int fh = aHeight + aSpread * 2;
+	// inside mask padded by the spread, so the search does not need bounds checks for the glyph
+	vector<unsigned char> tinside( (std::size_t)fw * fh, 0 );
+	for( int y = 0; y < aHeight; y++ ) {
+		for( int x = 0; x < aWidth; x++ ) {
+			tinside[ (std::size_t)(y + aSpread) * fw + x + aSpread ] = aCoverage[ (std::size_t)y * aWidth + x ] >= 128 ? 1 : 0;
+		}
+	}
+
+	float tmaxDist = (float)aSpread;
+	for( int y = 0; y < fh; y++ ) {
+		for( int x = 0; x < fw; x++ ) {
+			unsigned char tstate = tinside[ (std::size_t)y * fw + x ];
+			// squared distance to the closest pixel on the other side of the outline
+			int tbest = ( aSpread + 1 ) * ( aSpread + 1 );
+			int y0 = std::max( 0, y - aSpread );
+			int y1 = std::min( fh - 1, y + aSpread );
+			int x0 = std::max( 0, x - aSpread );
+			int x1 = std::min( fw - 1, x + aSpread );
+			for( int sy = y0; sy <= y1; sy++ ) {
+				int dy = sy - y;
+				const unsigned char* trow = &tinside[ (std::size_t)sy * fw ];
+				for( int sx = x0; sx <= x1; sx++ ) {
+					if( trow[sx] != tstate ) {
+						int dx = sx - x;
+						tbest = std::min( tbest, dx * dx + dy * dy );
+					}
+				}
+			}
+			// the outline is halfway between the pixel centers
+			float tdist = std::min( std::sqrt( (float)tbest ), tmaxDist + 0.5f ) - 0.5f;
+			if( !tstate ) tdist = -tdist;
+			float tvalue = 128.f + ( tdist / tmaxDist ) * 127.f;
+			aOut[ (std::size_t)y * aOutStride + x ] = (unsigned char)ofClamp( tvalue, 0.f, 255.f );
+		}
+	}
+}
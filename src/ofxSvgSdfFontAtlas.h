@@ -0,0 +1,80 @@
+//
+//  ofxSvgSdfFontAtlas.h
+//
+//  Signed distance field glyphs for one font file in a single texture. The glyphs are
+//  rasterized once at a base size when they are first used and drawn at any size with
+//  a shader, so a family does not need a font and texture per size.
+//
+
+#pragma once
+#include "ofxSvgFontMetrics.h"
+#include "ofMesh.h"
+#include "ofPixels.h"
+#include "ofTexture.h"
+#include "ofShader.h"
+
+namespace ofx::svg {
+class SdfFontAtlas {
+public:
+	struct Glyph {
+		// area in the page in pixels, empty for glyphs without an image, like spaces
+		ofRectangle rect;
+		// quad offset from the pen position and size at the base size, including the spread
+		float left = 0.f;
+		float top = 0.f;
+		float width = 0.f;
+		float height = 0.f;
+		float advance = 0.f;
+		unsigned int index = 0;
+	};
+
+	// aSpread is the distance in pixels at the base size that the field covers outside and inside of the outlines
+	bool setup( const std::string& aFontPath, int aBaseSize = 48, int aSpread = 6, int aPageSize = 1024 );
+	bool isSetup() { return mFace != nullptr; }
+	const std::string& getFontPath() { return mFontPath; }
+	int getBaseSize() { return mBaseSize; }
+
+	// adds two triangles per glyph for the string at aFontSize with the baseline at y,
+	// rasterizing glyphs that are not in the atlas yet. Same layout as ofTrueTypeFont::getStringMesh.
+	void addStringMesh( const std::string& aUtf8String, float x, float y, float aFontSize, ofMesh& aMesh );
+	float getStringWidth( const std::string& aUtf8String, float aFontSize );
+
+	// uploads the page again after glyphs were added, must be called from the gl thread
+	ofTexture& getTexture();
+	const ofPixels& getPixels() { return mPixels; }
+	std::size_t getNumGlyphs() { return mGlyphs.size(); }
+	bool isFull() { return mBFull; }
+
+	// binds the texture and the sdf shader, the color is the current color or the vertex colors
+	void begin( bool abVertexColors );
+	void end();
+
+	// computes the field from the coverage into aOut, which is aSpread pixels larger on each side.
+	// 128 is on the outline, larger values are inside.
+	static void sComputeField( const unsigned char* aCoverage, int aWidth, int aHeight, int aSpread, unsigned char* aOut, std::size_t aOutStride );
+
+	// will log messages to this module name
+	static const std::string moduleName() { return "ofx::svg::SdfFontAtlas"; }
+
+protected:
+	static ofShader& _getShader();
+	const Glyph* _getGlyph( uint32_t aCodepoint );
+	bool _addToPage( int aWidth, int aHeight, int& aX, int& aY );
+
+	std::shared_ptr<FontMetrics::Face> mFace;
+	std::string mFontPath;
+	int mBaseSize = 48;
+	int mSpread = 6;
+	int mPageSize = 1024;
+
+	std::unordered_map< uint32_t, Glyph > mGlyphs;
+	ofPixels mPixels;
+	ofTexture mTexture;
+	bool mBTextureDirty = true;
+	bool mBFull = false;
+	// current shelf that glyphs are added to
+	int mShelfX = 0;
+	int mShelfY = 0;
+	int mShelfHeight = 0;
+};
+}
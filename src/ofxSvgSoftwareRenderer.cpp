@@ -0,0 +1,574 @@
+//
+//  ofxSvgSoftwareRenderer.cpp
+//
+
+#include "ofxSvgSoftwareRenderer.h"
+#include "ofxSvgFontMetrics.h"
+#include "ofLog.h"
+#include <atomic>
+#include <thread>
+#include <cmath>
+
+using namespace ofx::svg;
+using std::vector;
+using std::shared_ptr;
+using std::string;
+
+//--------------------------------------------------------------
+static bool sIsInside( int aWinding, ofPolyWindingMode aMode ) {
+	switch( aMode ) {
+		case OF_POLY_WINDING_ODD:
+			return ( aWinding & 1 ) != 0;
+		case OF_POLY_WINDING_NONZERO:
+			return aWinding != 0;
+		case OF_POLY_WINDING_POSITIVE:
+			return aWinding > 0;
+		case OF_POLY_WINDING_NEGATIVE:
+			return aWinding < 0;
+		case OF_POLY_WINDING_ABS_GEQ_TWO:
+			return std::abs( aWinding ) >= 2;
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+static void sBlend( float* aDst, float r, float g, float b, float a ) {
+	// aDst is premultiplied
+	float ia = 1.f - a;
+	aDst[0] = r * a + aDst[0] * ia;
+	aDst[1] = g * a + aDst[1] * ia;
+	aDst[2] = b * a + aDst[2] * ia;
+	aDst[3] = a + aDst[3] * ia;
+}
+
+//--------------------------------------------------------------
+bool SoftwareRenderer::render( Group& aRoot, const ofRectangle& aViewRect, int aWidth, int aHeight, ofPixels& aPixels ) {
+	mItems.clear();
+	mNumTiles = 0;
+	if( aWidth < 1 || aHeight < 1 || aViewRect.width <= 0.f || aViewRect.height <= 0.f ) {
+		ofLogError(moduleName()) << __FUNCTION__ << " : invalid size " << aWidth << " x " << aHeight << " for view " << aViewRect;
+		return false;
+	}
+	mViewRect = aViewRect;
+	mWidth = aWidth;
+	mHeight = aHeight;
+	mScale = glm::vec2( (float)aWidth / aViewRect.width, (float)aHeight / aViewRect.height );
+
+	// same offset as Group::draw
+	_collectRecursive( aRoot, aRoot.pos );
+
+	aPixels.allocate( mWidth, mHeight, OF_IMAGE_COLOR_ALPHA );
+	mPixels = &aPixels;
+
+	vector<ofRectangle> ttiles;
+	for( int y = 0; y < mHeight; y += mTileSize ) {
+		for( int x = 0; x < mWidth; x += mTileSize ) {
+			ttiles.push_back( ofRectangle( x, y, std::min( mTileSize, mWidth - x ), std::min( mTileSize, mHeight - y )));
+		}
+	}
+	mNumTiles = ttiles.size();
+
+	// the items are read only from here on, so the tiles can be rasterized in any order
+	std::atomic<std::size_t> tnextTile( 0 );
+	auto tworker = [&]() {
+		vector<float> tcolors;
+		vector<float> tcoverage;
+		vector< std::pair<float, int> > tcrossings;
+		for( std::size_t i = tnextTile++; i < ttiles.size(); i = tnextTile++ ) {
+			_renderTile( ttiles[i], tcolors, tcoverage, tcrossings );
+		}
+	};
+
+	std::size_t tnumThreads = mNumThreads > 0 ? (std::size_t)mNumThreads : (std::size_t)std::max( 1u, std::thread::hardware_concurrency() );
+	tnumThreads = std::min( tnumThreads, ttiles.size() );
+	vector<std::thread> tthreads;
+	for( std::size_t i = 1; i < tnumThreads; i++ ) {
+		tthreads.emplace_back( tworker );
+	}
+	tworker();
+	for( auto& tthread : tthreads ) {
+		tthread.join();
+	}
+	mPixels = nullptr;
+	return true;
+}
+
+//--------------------------------------------------------------
+glm::vec2 SoftwareRenderer::_toPixels( const glm::vec2& aPoint ) const {
+	return glm::vec2( ( aPoint.x - mViewRect.x ) * mScale.x, ( aPoint.y - mViewRect.y ) * mScale.y );
+}
+
+//--------------------------------------------------------------
+void SoftwareRenderer::_collectRecursive( Group& aGroup, const glm::vec2& aOffset ) {
+	const Group& cgroup = aGroup;
+	for( auto& kid : cgroup.getChildren() ) {
+		if( !kid ) continue;
+		auto etype = kid->getType();
+		if( etype == TYPE_GROUP ) {
+			auto& kgroup = static_cast<Group&>( *kid );
+			_collectRecursive( kgroup, aOffset + kgroup.pos );
+			continue;
+		}
+		if( !kid->isVisible() ) continue;
+		if( etype == TYPE_TEXT ) {
+			_addText( static_cast<Text&>( *kid ), aOffset );
+		} else if( etype == TYPE_IMAGE ) {
+			_addImage( static_cast<Image&>( *kid ), aOffset );
+		} else if( etype == TYPE_PATH || etype == TYPE_RECTANGLE || etype == TYPE_CIRCLE || etype == TYPE_ELLIPSE ) {
+			_addPath( static_cast<Path&>( *kid ), aOffset );
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void SoftwareRenderer::_addPath( Path& aPath, const glm::vec2& aOffset ) {
+	const auto& toutlines = aPath.path.getOutline();
+	// same order as ofPath::draw, fill first and then the stroke
+	if( aPath.isFilled() ) {
+		Item titem;
+		titem.type = ITEM_POLYGON;
+		titem.windingMode = aPath.path.getWindingMode();
+		titem.color = aPath.getFillColor();
+		for( auto& tline : toutlines ) {
+			const auto& tverts = tline.getVertices();
+			if( tverts.size() < 3 ) continue;
+			// fills are always closed
+			for( std::size_t i = 0; i < tverts.size(); i++ ) {
+				const auto& a = tverts[i];
+				const auto& b = tverts[ (i + 1) % tverts.size() ];
+				_addEdge( titem, _toPixels( glm::vec2( a.x, a.y ) + aOffset ), _toPixels( glm::vec2( b.x, b.y ) + aOffset ));
+			}
+		}
+		if( _finishItem( titem )) {
+			mItems.push_back( std::move( titem ));
+		}
+	}
+	if( aPath.hasStroke() ) {
+		if( aPath.isStrokeTessellationEnabled() ) {
+			_addStrokeMesh( aPath.getStrokeMesh(), aOffset, aPath.getStrokeColor() );
+		} else {
+			_addStroke( toutlines, aOffset, aPath.getStrokeWidth(), aPath.getStrokeColor() );
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void SoftwareRenderer::_addStrokeMesh( const ofMesh& aMesh, const glm::vec2& aOffset, const ofFloatColor& aColor ) {
+	Item titem;
+	titem.type = ITEM_POLYGON;
+	// the triangles can overlap, so they are all added winding the same way
+	titem.windingMode = OF_POLY_WINDING_NONZERO;
+	titem.color = aColor;
+
+	const auto& tverts = aMesh.getVertices();
+	const auto& tindices = aMesh.getIndices();
+	for( std::size_t i = 0; i + 2 < tindices.size(); i += 3 ) {
+		glm::vec2 ta = _toPixels( glm::vec2( tverts[ tindices[i] ] ) + aOffset );
+		glm::vec2 tb = _toPixels( glm::vec2( tverts[ tindices[i+1] ] ) + aOffset );
+		glm::vec2 tc = _toPixels( glm::vec2( tverts[ tindices[i+2] ] ) + aOffset );
+		float tarea = ( tb.x - ta.x ) * ( tc.y - ta.y ) - ( tb.y - ta.y ) * ( tc.x - ta.x );
+		if( tarea == 0.f ) continue;
+		if( tarea > 0.f ) {
+			std::swap( tb, tc );
+		}
+		_addEdge( titem, ta, tb );
+		_addEdge( titem, tb, tc );
+		_addEdge( titem, tc, ta );
+	}
+	if( _finishItem( titem )) {
+		mItems.push_back( std::move( titem ));
+	}
+}
+
+//--------------------------------------------------------------
+void SoftwareRenderer::_addStroke( const vector<ofPolyline>& aOutlines, const glm::vec2& aOffset, float aStrokeWidth, const ofFloatColor& aColor ) {
+	float hw = aStrokeWidth * ( mScale.x + mScale.y ) * 0.25f;
+	if( hw <= 0.f ) return;
+
+	Item titem;
+	titem.type = ITEM_POLYGON;
+	// the segments and joins overlap, they all wind the same way
+	titem.windingMode = OF_POLY_WINDING_NONZERO;
+	titem.color = aColor;
+
+	int tnumJoinSegments = (int)ofClamp( std::ceil( hw * 2.f ), 8.f, 32.f );
+	auto addJoin = [&]( const glm::vec2& c ) {
+		// clockwise, like the segment quads
+		glm::vec2 prev = c + glm::vec2( hw, 0.f );
+		for( int k = 1; k <= tnumJoinSegments; k++ ) {
+			float ta = -TWO_PI * (float)k / (float)tnumJoinSegments;
+			glm::vec2 next = c + glm::vec2( std::cos( ta ), std::sin( ta )) * hw;
+			_addEdge( titem, prev, next );
+			prev = next;
+		}
+	};
+
+	for( auto& tline : aOutlines ) {
+		const auto& tverts = tline.getVertices();
+		if( tverts.size() < 2 ) continue;
+		vector<glm::vec2> tpoints;
+		tpoints.reserve( tverts.size() + 1 );
+		for( auto& v : tverts ) {
+			tpoints.push_back( _toPixels( glm::vec2( v.x, v.y ) + aOffset ));
+		}
+		bool bClosed = tline.isClosed();
+		if( bClosed ) {
+			tpoints.push_back( tpoints.front() );
+		}
+		for( std::size_t i = 0; i + 1 < tpoints.size(); i++ ) {
+			const auto& a = tpoints[i];
+			const auto& b = tpoints[i+1];
+			glm::vec2 tdir = b - a;
+			float tlen = glm::length( tdir );
+			if( tlen <= 0.f ) continue;
+			glm::vec2 n = glm::vec2( -tdir.y, tdir.x ) * ( hw / tlen );
+			_addEdge( titem, a + n, b + n );
+			_addEdge( titem, b + n, b - n );
+			_addEdge( titem, b - n, a - n );
+			_addEdge( titem, a - n, a + n );
+			// round joins between the segments, open ends are left butt capped
+			if( i + 2 < tpoints.size() || bClosed ) {
+				addJoin( b );
+			}
+		}
+	}
+	if( _finishItem( titem )) {
+		mItems.push_back( std::move( titem ));
+	}
+}
+
+//--------------------------------------------------------------
+void SoftwareRenderer::_addImage( Image& aImage, const glm::vec2& aOffset ) {
+	Item titem;
+	titem.type = ITEM_BITMAP;
+	titem.color = aImage.bUseShapeColor ? ofFloatColor( aImage.getColor() ) : ofFloatColor( 1.f, 1.f, 1.f, 1.f );
+	ofRectangle trect;
+	const ofPixels* tpixels = nullptr;
+	if( aImage.isInAtlas() ) {
+		trect = aImage.atlasRect;
+		tpixels = &aImage.atlasPage->getPixels();
+		titem.owner = aImage.atlasPage;
+	} else {
+		auto tentry = aImage.getCacheEntry( false );
+		if( !tentry ) return;
+		tentry->wait();
+		if( !tentry->isDecoded() || tentry->isFailed() ) return;
+		tpixels = &tentry->getPixels();
+		trect.set( 0, 0, tpixels->getWidth(), tpixels->getHeight() );
+		titem.owner = tentry;
+	}
+	if( !tpixels || !tpixels->getData() || trect.width < 1 || trect.height < 1 ) return;
+
+	titem.channels = (int)tpixels->getNumChannels();
+	titem.stride = tpixels->getWidth() * (std::size_t)titem.channels;
+	titem.data = tpixels->getData() + (std::size_t)trect.y * titem.stride + (std::size_t)trect.x * titem.channels;
+	titem.width = (int)trect.width;
+	titem.height = (int)trect.height;
+
+	// same transform as Image::draw
+	auto ttransform = aImage.getTransformMatrix();
+	glm::vec2 torigin = glm::vec2( ttransform[3] ) + aOffset;
+	glm::vec2 taxisX = glm::vec2( ttransform[0] ) * mScale;
+	glm::vec2 taxisY = glm::vec2( ttransform[1] ) * mScale;
+	if( _setBitmapTransform( titem, _toPixels( torigin ), taxisX, taxisY )) {
+		mItems.push_back( std::move( titem ));
+	}
+}
+
+//--------------------------------------------------------------
+void SoftwareRenderer::_addText( Text& aText, const glm::vec2& aOffset ) {
+	float tpixelScale = ( mScale.x + mScale.y ) * 0.5f;
+	// same rotation as Text::draw
+	float trotation = aText.rotation > 0 ? aText.rotation : 0.f;
+	glm::vec2 tright = glm::rotate( glm::vec2( 1.f, 0.f ), glm::radians( trotation ));
+	glm::vec2 tdown = glm::rotate( glm::vec2( 0.f, 1.f ), glm::radians( trotation ));
+	glm::vec2 ttextPos = aText.pos + aOffset;
+
+	for( auto& tspan : aText.textSpans ) {
+		if( tspan->text.empty() ) continue;
+		// glyphs are rendered at the size they cover in pixels
+		int tpixelSize = std::max( 1, (int)std::round( (float)tspan->fontSize * tpixelScale ));
+		auto tface = FontMetrics::sGetShared().get( aText.getFontPath( tspan->fontFamily ), tpixelSize );
+		if( !tface ) continue;
+		// bitmap pixels to document units
+		float tunit = (float)tspan->fontSize / (float)tpixelSize;
+
+		ofFloatColor tcolor = tspan->color;
+		tcolor.a *= aText.alpha;
+
+		float tstartX = tspan->rect.x;
+		if( aText.bCentered ) {
+			tstartX -= tface->getStringWidth( tspan->text ) * tunit * 0.5f;
+		}
+		float penX = 0.f;
+		float penY = 0.f;
+		unsigned int prevIndex = 0;
+		vector<unsigned char> tcoverage;
+		for( auto c : ofUTF8Iterator( tspan->text )) {
+			if( c == '\n' ) {
+				penX = 0.f;
+				penY += tface->getLineHeight();
+				prevIndex = 0;
+				continue;
+			}
+			if( c == '\t' ) {
+				penX += tface->getGlyph( ' ' ).advance * 4.f;
+				prevIndex = 0;
+				continue;
+			}
+			auto tglyph = tface->getGlyph( c );
+			penX += tface->getKerning( prevIndex, tglyph.index );
+			prevIndex = tglyph.index;
+
+			int tw = 0, th = 0, tleft = 0, ttop = 0;
+			if( tface->renderGlyph( c, tcoverage, tw, th, tleft, ttop )) {
+				Item titem;
+				titem.type = ITEM_BITMAP;
+				titem.color = tcolor;
+				titem.ownedData.swap( tcoverage );
+				titem.data = titem.ownedData.data();
+				titem.channels = 1;
+				titem.stride = (std::size_t)tw;
+				titem.width = tw;
+				titem.height = th;
+
+				glm::vec2 tlocal( tstartX + ( penX + (float)tleft ) * tunit, tspan->rect.y + ( penY - (float)ttop ) * tunit );
+				glm::vec2 torigin = ttextPos + tright * tlocal.x + tdown * tlocal.y;
+				if( _setBitmapTransform( titem, _toPixels( torigin ), tright * tunit * mScale, tdown * tunit * mScale )) {
+					mItems.push_back( std::move( titem ));
+				}
+			}
+			penX += tglyph.advance;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void SoftwareRenderer::_addEdge( Item& aItem, const glm::vec2& a, const glm::vec2& b ) {
+	if( a.y == b.y ) return;
+	Edge tedge;
+	if( a.y < b.y ) {
+		tedge.x0 = a.x; tedge.y0 = a.y;
+		tedge.x1 = b.x; tedge.y1 = b.y;
+		tedge.winding = 1;
+	} else {
+		tedge.x0 = b.x; tedge.y0 = b.y;
+		tedge.x1 = a.x; tedge.y1 = a.y;
+		tedge.winding = -1;
+	}
+	tedge.dxdy = ( tedge.x1 - tedge.x0 ) / ( tedge.y1 - tedge.y0 );
+	aItem.edges.push_back( tedge );
+}
+
+//--------------------------------------------------------------
+bool SoftwareRenderer::_setBitmapTransform( Item& aItem, const glm::vec2& aOrigin, const glm::vec2& aAxisX, const glm::vec2& aAxisY ) {
+	// inverse of the 2x2 matrix with the axes as columns
+	float tdet = aAxisX.x * aAxisY.y - aAxisY.x * aAxisX.y;
+	if( std::fabs( tdet ) < 1e-12f ) return false;
+	aItem.axisX = glm::vec2( aAxisY.y, -aAxisX.y ) / tdet;
+	aItem.axisY = glm::vec2( -aAxisY.x, aAxisX.x ) / tdet;
+	aItem.origin = -( aItem.axisX * aOrigin.x + aItem.axisY * aOrigin.y );
+
+	float tminX = aOrigin.x, tmaxX = aOrigin.x;
+	float tminY = aOrigin.y, tmaxY = aOrigin.y;
+	const glm::vec2 tcorners[3] = { aOrigin + aAxisX * (float)aItem.width, aOrigin + aAxisY * (float)aItem.height, aOrigin + aAxisX * (float)aItem.width + aAxisY * (float)aItem.height };
+	for( auto& tcorner : tcorners ) {
+		tminX = std::min( tminX, tcorner.x );
+		tmaxX = std::max( tmaxX, tcorner.x );
+		tminY = std::min( tminY, tcorner.y );
+		tmaxY = std::max( tmaxY, tcorner.y );
+	}
+	aItem.minX = std::max( 0, (int)std::floor( tminX ));
+	aItem.minY = std::max( 0, (int)std::floor( tminY ));
+	aItem.maxX = std::min( mWidth, (int)std::ceil( tmaxX ));
+	aItem.maxY = std::min( mHeight, (int)std::ceil( tmaxY ));
+	return aItem.minX < aItem.maxX && aItem.minY < aItem.maxY;
+}
+
+//--------------------------------------------------------------
+bool SoftwareRenderer::_finishItem( Item& aItem ) {
+	if( aItem.edges.empty() || aItem.color.a <= 0.f ) return false;
+	float tminX = aItem.edges[0].x0, tmaxX = tminX;
+	float tminY = aItem.edges[0].y0, tmaxY = aItem.edges[0].y1;
+	for( auto& tedge : aItem.edges ) {
+		tminX = std::min( tminX, std::min( tedge.x0, tedge.x1 ));
+		tmaxX = std::max( tmaxX, std::max( tedge.x0, tedge.x1 ));
+		tminY = std::min( tminY, tedge.y0 );
+		tmaxY = std::max( tmaxY, tedge.y1 );
+	}
+	aItem.minX = std::max( 0, (int)std::floor( tminX ));
+	aItem.minY = std::max( 0, (int)std::floor( tminY ));
+	aItem.maxX = std::min( mWidth, (int)std::ceil( tmaxX ));
+	aItem.maxY = std::min( mHeight, (int)std::ceil( tmaxY ));
+	if( aItem.minX >= aItem.maxX || aItem.minY >= aItem.maxY ) return false;
+	std::sort( aItem.edges.begin(), aItem.edges.end(), []( const Edge& a, const Edge& b ) { return a.y0 < b.y0; });
+	return true;
+}
+
+//--------------------------------------------------------------
+void SoftwareRenderer::_renderTile( const ofRectangle& aTile, vector<float>& aColors, vector<float>& aCoverage, vector< std::pair<float, int> >& aCrossings ) {
+	int tx = (int)aTile.x;
+	int ty = (int)aTile.y;
+	int tw = (int)aTile.width;
+	int th = (int)aTile.height;
+
+	float tbgAlpha = mBackgroundColor.a;
+	aColors.resize( (std::size_t)tw * th * 4 );
+	for( std::size_t i = 0; i < aColors.size(); i += 4 ) {
+		aColors[i+0] = mBackgroundColor.r * tbgAlpha;
+		aColors[i+1] = mBackgroundColor.g * tbgAlpha;
+		aColors[i+2] = mBackgroundColor.b * tbgAlpha;
+		aColors[i+3] = tbgAlpha;
+	}
+
+	for( auto& titem : mItems ) {
+		if( titem.maxX <= tx || titem.minX >= tx + tw || titem.maxY <= ty || titem.minY >= ty + th ) continue;
+		if( titem.type == ITEM_POLYGON ) {
+			_fillPolygon( titem, aTile, aColors, aCoverage, aCrossings );
+		} else {
+			_drawBitmap( titem, aTile, aColors );
+		}
+	}
+
+	// tiles do not overlap, so they can be written from any thread
+	unsigned char* tdst = mPixels->getData();
+	for( int y = 0; y < th; y++ ) {
+		unsigned char* trow = tdst + ( (std::size_t)( ty + y ) * mWidth + tx ) * 4;
+		const float* tsrc = &aColors[ (std::size_t)y * tw * 4 ];
+		for( int x = 0; x < tw; x++ ) {
+			float a = tsrc[x*4+3];
+			float ia = a > 0.f ? 1.f / a : 0.f;
+			trow[x*4+0] = (unsigned char)ofClamp( tsrc[x*4+0] * ia * 255.f + 0.5f, 0.f, 255.f );
+			trow[x*4+1] = (unsigned char)ofClamp( tsrc[x*4+1] * ia * 255.f + 0.5f, 0.f, 255.f );
+			trow[x*4+2] = (unsigned char)ofClamp( tsrc[x*4+2] * ia * 255.f + 0.5f, 0.f, 255.f );
+			trow[x*4+3] = (unsigned char)ofClamp( a * 255.f + 0.5f, 0.f, 255.f );
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void SoftwareRenderer::_fillPolygon( const Item& aItem, const ofRectangle& aTile, vector<float>& aColors, vector<float>& aCoverage, vector< std::pair<float, int> >& aCrossings ) {
+	int tx = (int)aTile.x;
+	int ty = (int)aTile.y;
+	int tw = (int)aTile.width;
+	int x0 = std::max( tx, aItem.minX );
+	int x1 = std::min( tx + (int)aTile.width, aItem.maxX );
+	int y0 = std::max( ty, aItem.minY );
+	int y1 = std::min( ty + (int)aTile.height, aItem.maxY );
+	if( x0 >= x1 || y0 >= y1 ) return;
+
+	float tsampleWeight = 1.f / (float)mNumSamples;
+	float fx0 = (float)x0;
+	float fx1 = (float)x1;
+	aCoverage.resize( (std::size_t)( x1 - x0 ));
+
+	// adds the area of [xa, xb) on one sample row to the coverage
+	auto addSpan = [&]( float xa, float xb ) {
+		xa = std::max( xa, fx0 );
+		xb = std::min( xb, fx1 );
+		if( xa >= xb ) return;
+		int ia = (int)xa;
+		int ib = (int)xb;
+		if( ia == ib ) {
+			aCoverage[ ia - x0 ] += ( xb - xa ) * tsampleWeight;
+			return;
+		}
+		aCoverage[ ia - x0 ] += ( (float)( ia + 1 ) - xa ) * tsampleWeight;
+		for( int i = ia + 1; i < ib; i++ ) {
+			aCoverage[ i - x0 ] += tsampleWeight;
+		}
+		if( ib < x1 ) {
+			aCoverage[ ib - x0 ] += ( xb - (float)ib ) * tsampleWeight;
+		}
+	};
+
+	for( int y = y0; y < y1; y++ ) {
+		std::fill( aCoverage.begin(), aCoverage.end(), 0.f );
+		bool bAny = false;
+		for( int s = 0; s < mNumSamples; s++ ) {
+			float sy = (float)y + ( (float)s + 0.5f ) * tsampleWeight;
+			aCrossings.clear();
+			for( auto& tedge : aItem.edges ) {
+				// sorted by the top
+				if( tedge.y0 > sy ) break;
+				if( sy >= tedge.y1 ) continue;
+				aCrossings.push_back( std::make_pair( tedge.x0 + ( sy - tedge.y0 ) * tedge.dxdy, tedge.winding ));
+			}
+			if( aCrossings.size() < 2 ) continue;
+			std::sort( aCrossings.begin(), aCrossings.end() );
+
+			int twinding = 0;
+			float tspanStart = 0.f;
+			for( auto& tcrossing : aCrossings ) {
+				bool bWasInside = sIsInside( twinding, aItem.windingMode );
+				twinding += tcrossing.second;
+				bool bInside = sIsInside( twinding, aItem.windingMode );
+				if( !bWasInside && bInside ) {
+					tspanStart = tcrossing.first;
+				} else if( bWasInside && !bInside ) {
+					addSpan( tspanStart, tcrossing.first );
+					bAny = true;
+				}
+			}
+		}
+		if( !bAny ) continue;
+
+		float* trow = &aColors[ ( (std::size_t)( y - ty ) * tw + ( x0 - tx )) * 4 ];
+		for( int x = 0; x < x1 - x0; x++ ) {
+			float tcoverage = std::min( aCoverage[x], 1.f );
+			if( tcoverage <= 0.f ) continue;
+			sBlend( trow + x * 4, aItem.color.r, aItem.color.g, aItem.color.b, aItem.color.a * tcoverage );
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void SoftwareRenderer::_drawBitmap( const Item& aItem, const ofRectangle& aTile, vector<float>& aColors ) {
+	int tx = (int)aTile.x;
+	int ty = (int)aTile.y;
+	int tw = (int)aTile.width;
+	int x0 = std::max( tx, aItem.minX );
+	int x1 = std::min( tx + (int)aTile.width, aItem.maxX );
+	int y0 = std::max( ty, aItem.minY );
+	int y1 = std::min( ty + (int)aTile.height, aItem.maxY );
+	if( x0 >= x1 || y0 >= y1 ) return;
+
+	const int tc = aItem.channels;
+	float tsample[4];
+	for( int y = y0; y < y1; y++ ) {
+		float* trow = &aColors[ ( (std::size_t)( y - ty ) * tw ) * 4 ];
+		for( int x = x0; x < x1; x++ ) {
+			glm::vec2 src = aItem.origin + aItem.axisX * ( (float)x + 0.5f ) + aItem.axisY * ( (float)y + 0.5f );
+			if( src.x < 0.f || src.y < 0.f || src.x >= (float)aItem.width || src.y >= (float)aItem.height ) continue;
+
+			// bilinear between the pixel centers, clamped at the edges
+			float fx = std::max( src.x - 0.5f, 0.f );
+			float fy = std::max( src.y - 0.5f, 0.f );
+			int ix = std::min( (int)fx, aItem.width - 1 );
+			int iy = std::min( (int)fy, aItem.height - 1 );
+			int ix1 = std::min( ix + 1, aItem.width - 1 );
+			int iy1 = std::min( iy + 1, aItem.height - 1 );
+			float ax = fx - (float)ix;
+			float ay = fy - (float)iy;
+			const unsigned char* p00 = aItem.data + (std::size_t)iy * aItem.stride + (std::size_t)ix * tc;
+			const unsigned char* p10 = aItem.data + (std::size_t)iy * aItem.stride + (std::size_t)ix1 * tc;
+			const unsigned char* p01 = aItem.data + (std::size_t)iy1 * aItem.stride + (std::size_t)ix * tc;
+			const unsigned char* p11 = aItem.data + (std::size_t)iy1 * aItem.stride + (std::size_t)ix1 * tc;
+			for( int k = 0; k < tc && k < 4; k++ ) {
+				float top = (float)p00[k] + ( (float)p10[k] - (float)p00[k] ) * ax;
+				float bottom = (float)p01[k] + ( (float)p11[k] - (float)p01[k] ) * ax;
+				tsample[k] = ( top + ( bottom - top ) * ay ) / 255.f;
+			}
+
+			if( tc == 1 ) {
+				// glyph coverage
+				sBlend( trow + ( x - tx ) * 4, aItem.color.r, aItem.color.g, aItem.color.b, aItem.color.a * tsample[0] );
+			} else if( tc == 2 ) {
+				sBlend( trow + ( x - tx ) * 4, tsample[0] * aItem.color.r, tsample[0] * aItem.color.g, tsample[0] * aItem.color.b, tsample[1] * aItem.color.a );
+			} else {
+				float ta = tc == 4 ? tsample[3] : 1.f;
+				sBlend( trow + ( x - tx ) * 4, tsample[0] * aItem.color.r, tsample[1] * aItem.color.g, tsample[2] * aItem.color.b, ta * aItem.color.a );
+			}
+		}
+	}
+}
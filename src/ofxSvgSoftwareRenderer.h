@@ -0,0 +1,107 @@
+//
+//  ofxSvgSoftwareRenderer.h
+//
+//  Renders a document into ofPixels on the cpu, without a gl context. The elements are
+//  converted to edge lists and bitmaps once, then the image is split into tiles that are
+//  rasterized in parallel with anti-aliased scanlines.
+//
+
+#pragma once
+#include "ofxSvgGroup.h"
+#include "ofPixels.h"
+
+namespace ofx::svg {
+class SoftwareRenderer {
+public:
+	// renders the area aViewRect of the document into aPixels, which is allocated as rgba with aWidth x aHeight.
+	// Images are decoded first if they are still loading.
+	bool render( Group& aRoot, const ofRectangle& aViewRect, int aWidth, int aHeight, ofPixels& aPixels );
+
+	// 0 uses one thread per core
+	void setNumThreads( int aNumThreads ) { mNumThreads = std::max( 0, aNumThreads ); }
+	void setTileSize( int aTileSize ) { mTileSize = std::max( 8, aTileSize ); }
+	// vertical samples per pixel, the coverage along a scanline is exact
+	void setNumSamples( int aNumSamples ) { mNumSamples = std::max( 1, aNumSamples ); }
+	void setBackgroundColor( const ofFloatColor& aColor ) { mBackgroundColor = aColor; }
+
+	// items rasterized by the last render
+	std::size_t getNumItems() { return mItems.size(); }
+	std::size_t getNumTiles() { return mNumTiles; }
+
+	// will log messages to this module name
+	static const std::string moduleName() { return "ofx::svg::SoftwareRenderer"; }
+
+protected:
+	struct Edge {
+		// top to bottom in pixels
+		float x0, y0, x1, y1;
+		float dxdy;
+		int winding;
+	};
+
+	enum ItemType {
+		ITEM_POLYGON = 0,
+		ITEM_BITMAP
+	};
+
+	struct Item {
+		ItemType type = ITEM_POLYGON;
+		// area in pixels that the item can touch
+		int minX = 0;
+		int minY = 0;
+		int maxX = 0;
+		int maxY = 0;
+		ofFloatColor color;
+
+		// ITEM_POLYGON, sorted by y0
+		std::vector<Edge> edges;
+		ofPolyWindingMode windingMode = OF_POLY_WINDING_ODD;
+
+		// ITEM_BITMAP, 1 channel bitmaps are coverage tinted by the color
+		const unsigned char* data = nullptr;
+		int width = 0;
+		int height = 0;
+		int channels = 4;
+		std::size_t stride = 0;
+		// maps a pixel center to the bitmap, src = origin + x * axisX + y * axisY
+		glm::vec2 origin;
+		glm::vec2 axisX;
+		glm::vec2 axisY;
+		// keeps the pixels alive while rendering
+		std::shared_ptr<void> owner;
+		std::vector<unsigned char> ownedData;
+	};
+
+	void _collectRecursive( Group& aGroup, const glm::vec2& aOffset );
+	void _addPath( Path& aPath, const glm::vec2& aOffset );
+	void _addStroke( const std::vector<ofPolyline>& aOutlines, const glm::vec2& aOffset, float aStrokeWidth, const ofFloatColor& aColor );
+	// the cached stroke triangles of a path, see Path::getStrokeMesh
+	void _addStrokeMesh( const ofMesh& aMesh, const glm::vec2& aOffset, const ofFloatColor& aColor );
+	void _addImage( Image& aImage, const glm::vec2& aOffset );
+	void _addText( Text& aText, const glm::vec2& aOffset );
+	void _addEdge( Item& aItem, const glm::vec2& a, const glm::vec2& b );
+	// sets the mapping from pixels to the bitmap from the pixel position of its top left and its axes
+	bool _setBitmapTransform( Item& aItem, const glm::vec2& aOrigin, const glm::vec2& aAxisX, const glm::vec2& aAxisY );
+	bool _finishItem( Item& aItem );
+	glm::vec2 _toPixels( const glm::vec2& aPoint ) const;
+
+	void _renderTile( const ofRectangle& aTile, std::vector<float>& aColors, std::vector<float>& aCoverage, std::vector< std::pair<float, int> >& aCrossings );
+	// the tile is the area in pixels that aColors covers
+	void _fillPolygon( const Item& aItem, const ofRectangle& aTile, std::vector<float>& aColors, std::vector<float>& aCoverage, std::vector< std::pair<float, int> >& aCrossings );
+	void _drawBitmap( const Item& aItem, const ofRectangle& aTile, std::vector<float>& aColors );
+
+	int mNumThreads = 0;
+	int mTileSize = 64;
+	int mNumSamples = 4;
+	ofFloatColor mBackgroundColor = ofFloatColor( 0.f, 0.f, 0.f, 0.f );
+
+	// document to pixels for the current render
+	ofRectangle mViewRect;
+	glm::vec2 mScale = glm::vec2( 1.f, 1.f );
+	int mWidth = 0;
+	int mHeight = 0;
+	std::size_t mNumTiles = 0;
+	std::vector<Item> mItems;
+	ofPixels* mPixels = nullptr;
+};
+}
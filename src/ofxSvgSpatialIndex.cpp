@@ -0,0 +1,313 @@
+//
+//  ofxSvgSpatialIndex.cpp
+//
+
+#include "ofxSvgSpatialIndex.h"
+#include "ofxSvgGroup.h"
+#include <algorithm>
+
+using namespace ofx::svg;
+using std::vector;
+using std::shared_ptr;
+
+//--------------------------------------------------------------
+void SpatialIndex::build( Group& aRoot ) {
+	clear();
+	_collectRecursive( aRoot, aRoot.pos );
+	if( mItems.size() ) {
+		mNodes.reserve( (mItems.size() / sMaxItemsPerLeaf) * 2 + 1 );
+		_buildRecursive( 0, mItems.size(), -1 );
+	}
+	mItemForElement.reserve( mItems.size() );
+	for( std::size_t i = 0; i < mItems.size(); i++ ) {
+		mItemForElement[ mItems[i].element.get() ] = i;
+	}
+}
+
+//--------------------------------------------------------------
+void SpatialIndex::clear() {
+	mItems.clear();
+	mNodes.clear();
+	mItemForElement.clear();
+}
+
+//--------------------------------------------------------------
+bool SpatialIndex::update( const shared_ptr<Element>& aElement ) {
+	if( !aElement ) return false;
+	auto it = mItemForElement.find( aElement.get() );
+	if( it == mItemForElement.end() ) {
+		return false;
+	}
+	auto& item = mItems[it->second];
+	ofRectangle tbounds;
+	if( sComputeBounds( *aElement, tbounds )) {
+		item.min = glm::vec2( tbounds.getMinX(), tbounds.getMinY() );
+		item.max = glm::vec2( tbounds.getMaxX(), tbounds.getMaxY() );
+	} else {
+		// no geometry anymore, keep it in the tree as a point so the indices stay valid
+		item.max = item.min;
+	}
+	// refit the leaf and then all of the nodes above it
+	int nodeIndex = item.node;
+	while( nodeIndex >= 0 ) {
+		_refitNode( nodeIndex );
+		nodeIndex = mNodes[nodeIndex].parent;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+vector< shared_ptr<Element> > SpatialIndex::queryRect( const ofRectangle& aRect ) {
+	vector< shared_ptr<Element> > relements;
+	queryRect( aRect, relements );
+	return relements;
+}
+
+//--------------------------------------------------------------
+void SpatialIndex::queryRect( const ofRectangle& aRect, vector< shared_ptr<Element> >& aResults ) {
+	if( mNodes.empty() ) return;
+	glm::vec2 qmin( aRect.getMinX(), aRect.getMinY() );
+	glm::vec2 qmax( aRect.getMaxX(), aRect.getMaxY() );
+
+	auto overlaps = [&qmin, &qmax]( const glm::vec2& amin, const glm::vec2& amax ) -> bool {
+		return amin.x <= qmax.x && amax.x >= qmin.x && amin.y <= qmax.y && amax.y >= qmin.y;
+	};
+
+	mStack.clear();
+	mStack.push_back(0);
+	while( mStack.size() ) {
+		const Node& node = mNodes[ mStack.back() ];
+		mStack.pop_back();
+		if( !overlaps( node.min, node.max )) continue;
+		if( node.isLeaf() ) {
+			for( std::size_t i = node.start; i < node.start + node.count; i++ ) {
+				if( overlaps( mItems[i].min, mItems[i].max )) {
+					aResults.push_back( mItems[i].element );
+				}
+			}
+		} else {
+			mStack.push_back( node.right );
+			mStack.push_back( node.left );
+		}
+	}
+}
+
+//--------------------------------------------------------------
+vector< shared_ptr<Element> > SpatialIndex::queryPoint( const glm::vec2& aPoint ) {
+	vector< shared_ptr<Element> > relements;
+	queryPoint( aPoint, relements );
+	return relements;
+}
+
+//--------------------------------------------------------------
+void SpatialIndex::queryPoint( const glm::vec2& aPoint, vector< shared_ptr<Element> >& aResults ) {
+	queryRect( ofRectangle( aPoint.x, aPoint.y, 0.f, 0.f ), aResults );
+}
+
+//--------------------------------------------------------------
+shared_ptr<Element> SpatialIndex::nearest( const glm::vec2& aPoint, float aMaxDistance ) {
+	shared_ptr<Element> relement;
+	if( mNodes.empty() ) return relement;
+
+	float bestDist2 = aMaxDistance < std::numeric_limits<float>::max() ? aMaxDistance * aMaxDistance : aMaxDistance;
+
+	mStack.clear();
+	mStack.push_back(0);
+	while( mStack.size() ) {
+		const Node& node = mNodes[ mStack.back() ];
+		mStack.pop_back();
+		if( _distanceSquared( aPoint, node.min, node.max ) > bestDist2 ) continue;
+		if( node.isLeaf() ) {
+			for( std::size_t i = node.start; i < node.start + node.count; i++ ) {
+				float dist2 = _distanceSquared( aPoint, mItems[i].min, mItems[i].max );
+				if( dist2 <= bestDist2 ) {
+					bestDist2 = dist2;
+					relement = mItems[i].element;
+				}
+			}
+		} else {
+			// visit the closer child first so that more of the tree gets pruned
+			const Node& left = mNodes[node.left];
+			const Node& right = mNodes[node.right];
+			if( _distanceSquared( aPoint, left.min, left.max ) < _distanceSquared( aPoint, right.min, right.max )) {
+				mStack.push_back( node.right );
+				mStack.push_back( node.left );
+			} else {
+				mStack.push_back( node.left );
+				mStack.push_back( node.right );
+			}
+		}
+	}
+	return relement;
+}
+
+//--------------------------------------------------------------
+bool SpatialIndex::getBounds( const shared_ptr<Element>& aElement, ofRectangle& aBounds ) {
+	if( !aElement ) return false;
+	auto it = mItemForElement.find( aElement.get() );
+	if( it == mItemForElement.end() ) {
+		return false;
+	}
+	auto& item = mItems[it->second];
+	aBounds.set( item.min.x, item.min.y, item.max.x - item.min.x, item.max.y - item.min.y );
+	return true;
+}
+
+//--------------------------------------------------------------
+bool SpatialIndex::sComputeBounds( Element& aElement, ofRectangle& aBounds ) {
+	// Group::draw translates by the position of each group
+	glm::vec2 offset( 0.f, 0.f );
+	Group* parent = aElement.getParent();
+	while( parent ) {
+		offset += parent->pos;
+		parent = parent->getParent();
+	}
+	return sComputeBounds( aElement, offset, aBounds );
+}
+
+//--------------------------------------------------------------
+bool SpatialIndex::sComputeBounds( Element& aElement, const glm::vec2& aOffset, ofRectangle& aBounds ) {
+	glm::vec2 tmin( std::numeric_limits<float>::max() );
+	glm::vec2 tmax( -std::numeric_limits<float>::max() );
+	bool bHasPoints = false;
+
+	auto addPoint = [&]( const glm::vec3& ap ) {
+		tmin.x = std::min( tmin.x, ap.x );
+		tmin.y = std::min( tmin.y, ap.y );
+		tmax.x = std::max( tmax.x, ap.x );
+		tmax.y = std::max( tmax.y, ap.y );
+		bHasPoints = true;
+	};
+
+	auto etype = aElement.getType();
+	if( etype == TYPE_TEXT ) {
+		auto& etext = static_cast<Text&>( aElement );
+		if( etext.textSpans.size() ) {
+			auto trect = etext.getRectangle();
+			addPoint( trect.getTopLeft() );
+			addPoint( trect.getBottomRight() );
+		}
+	} else if( etype == TYPE_IMAGE ) {
+		auto& eimage = static_cast<Image&>( aElement );
+		// images are drawn at pos with rotation and scale applied
+		auto transform = eimage.getTransformMatrix();
+		addPoint( transform * glm::vec4( 0.f, 0.f, 0.f, 1.f ));
+		addPoint( transform * glm::vec4( eimage.width, 0.f, 0.f, 1.f ));
+		addPoint( transform * glm::vec4( eimage.width, eimage.height, 0.f, 1.f ));
+		addPoint( transform * glm::vec4( 0.f, eimage.height, 0.f, 1.f ));
+	} else if( etype == TYPE_PATH || etype == TYPE_RECTANGLE || etype == TYPE_CIRCLE || etype == TYPE_ELLIPSE ) {
+		// the transforms have already been applied to the path points when parsing
+		auto& epath = static_cast<Path&>( aElement );
+		for( auto& outline : epath.path.getOutline() ) {
+			for( auto& v : outline.getVertices() ) {
+				addPoint( v );
+			}
+		}
+		if( bHasPoints && epath.hasStroke() ) {
+			float halfStroke = epath.getStrokeWidth() * 0.5f;
+			tmin -= glm::vec2( halfStroke, halfStroke );
+			tmax += glm::vec2( halfStroke, halfStroke );
+		}
+	}
+
+	if( !bHasPoints ) {
+		return false;
+	}
+	aBounds.set( tmin.x + aOffset.x, tmin.y + aOffset.y, tmax.x - tmin.x, tmax.y - tmin.y );
+	return true;
+}
+
+//--------------------------------------------------------------
+void SpatialIndex::_collectRecursive( Group& aGroup, const glm::vec2& aOffset ) {
+	const Group& cgroup = aGroup;
+	for( auto& kid : cgroup.getChildren() ) {
+		if( !kid ) continue;
+		if( kid->isGroup() ) {
+			auto& kgroup = static_cast<Group&>( *kid );
+			_collectRecursive( kgroup, aOffset + kgroup.pos );
+			continue;
+		}
+		ofRectangle tbounds;
+		if( !sComputeBounds( *kid, aOffset, tbounds )) {
+			continue;
+		}
+		Item item;
+		item.element = kid;
+		item.min = glm::vec2( tbounds.getMinX(), tbounds.getMinY() );
+		item.max = glm::vec2( tbounds.getMaxX(), tbounds.getMaxY() );
+		mItems.push_back( item );
+	}
+}
+
+// top down build, splits the items at the median of the longest axis of their centers
+//--------------------------------------------------------------
+int SpatialIndex::_buildRecursive( std::size_t aStart, std::size_t aCount, int aParent ) {
+	int nodeIndex = (int)mNodes.size();
+	mNodes.push_back( Node() );
+	mNodes[nodeIndex].parent = aParent;
+
+	if( aCount <= sMaxItemsPerLeaf ) {
+		mNodes[nodeIndex].start = aStart;
+		mNodes[nodeIndex].count = aCount;
+		for( std::size_t i = aStart; i < aStart + aCount; i++ ) {
+			mItems[i].node = nodeIndex;
+		}
+		_refitNode( nodeIndex );
+		return nodeIndex;
+	}
+
+	glm::vec2 cmin( std::numeric_limits<float>::max() );
+	glm::vec2 cmax( -std::numeric_limits<float>::max() );
+	for( std::size_t i = aStart; i < aStart + aCount; i++ ) {
+		glm::vec2 center = (mItems[i].min + mItems[i].max) * 0.5f;
+		cmin.x = std::min( cmin.x, center.x );
+		cmin.y = std::min( cmin.y, center.y );
+		cmax.x = std::max( cmax.x, center.x );
+		cmax.y = std::max( cmax.y, center.y );
+	}
+	int axis = (cmax.x - cmin.x) >= (cmax.y - cmin.y) ? 0 : 1;
+
+	std::size_t half = aCount / 2;
+	std::nth_element( mItems.begin() + aStart, mItems.begin() + aStart + half, mItems.begin() + aStart + aCount,
+					 [axis]( const Item& a, const Item& b ) {
+		return (a.min[axis] + a.max[axis]) < (b.min[axis] + b.max[axis]);
+	});
+
+	int left = _buildRecursive( aStart, half, nodeIndex );
+	int right = _buildRecursive( aStart + half, aCount - half, nodeIndex );
+	// mNodes may have been reallocated
+	mNodes[nodeIndex].left = left;
+	mNodes[nodeIndex].right = right;
+	_refitNode( nodeIndex );
+	return nodeIndex;
+}
+
+//--------------------------------------------------------------
+void SpatialIndex::_refitNode( int aNodeIndex ) {
+	Node& node = mNodes[aNodeIndex];
+	glm::vec2 tmin( std::numeric_limits<float>::max() );
+	glm::vec2 tmax( -std::numeric_limits<float>::max() );
+	auto grow = [&tmin, &tmax]( const glm::vec2& amin, const glm::vec2& amax ) {
+		tmin.x = std::min( tmin.x, amin.x );
+		tmin.y = std::min( tmin.y, amin.y );
+		tmax.x = std::max( tmax.x, amax.x );
+		tmax.y = std::max( tmax.y, amax.y );
+	};
+	if( node.isLeaf() ) {
+		for( std::size_t i = node.start; i < node.start + node.count; i++ ) {
+			grow( mItems[i].min, mItems[i].max );
+		}
+	} else {
+		grow( mNodes[node.left].min, mNodes[node.left].max );
+		grow( mNodes[node.right].min, mNodes[node.right].max );
+	}
+	node.min = tmin;
+	node.max = tmax;
+}
+
+//--------------------------------------------------------------
+float SpatialIndex::_distanceSquared( const glm::vec2& aPoint, const glm::vec2& aMin, const glm::vec2& aMax ) {
+	float dx = std::max( std::max( aMin.x - aPoint.x, 0.f ), aPoint.x - aMax.x );
+	float dy = std::max( std::max( aMin.y - aPoint.y, 0.f ), aPoint.y - aMax.y );
+	return dx * dx + dy * dy;
+}
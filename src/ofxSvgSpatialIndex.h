@@ -0,0 +1,78 @@
+//
+//  ofxSvgSpatialIndex.h
+//
+//  Bounding volume hierarchy over the document space bounds of the elements,
+//  for culling, picking and layout queries on large documents.
+//
+
+#pragma once
+#include "ofxSvgElements.h"
+#include <unordered_map>
+#include <limits>
+
+namespace ofx::svg {
+class Group;
+
+class SpatialIndex {
+public:
+	// builds the hierarchy from all of the non group elements below aRoot
+	void build( Group& aRoot );
+	void clear();
+
+	// call after an element has moved or changed geometry, refits the nodes above it.
+	// returns false if the element is not in the index.
+	bool update( const std::shared_ptr<Element>& aElement );
+
+	bool isEmpty() { return mItems.empty(); }
+	std::size_t getNumElements() { return mItems.size(); }
+
+	// elements with bounds intersecting the rectangle
+	std::vector< std::shared_ptr<Element> > queryRect( const ofRectangle& aRect );
+	void queryRect( const ofRectangle& aRect, std::vector< std::shared_ptr<Element> >& aResults );
+	// elements with bounds containing the point
+	std::vector< std::shared_ptr<Element> > queryPoint( const glm::vec2& aPoint );
+	void queryPoint( const glm::vec2& aPoint, std::vector< std::shared_ptr<Element> >& aResults );
+	// element with bounds closest to the point, distance is 0 when inside of the bounds
+	std::shared_ptr<Element> nearest( const glm::vec2& aPoint, float aMaxDistance = std::numeric_limits<float>::max() );
+
+	// document space bounds of the element that were stored in the index
+	bool getBounds( const std::shared_ptr<Element>& aElement, ofRectangle& aBounds );
+
+	// document space bounds for an element, accounting for the positions of the parent groups.
+	// returns false if the element does not have any geometry.
+	static bool sComputeBounds( Element& aElement, ofRectangle& aBounds );
+	static bool sComputeBounds( Element& aElement, const glm::vec2& aOffset, ofRectangle& aBounds );
+
+protected:
+	struct Item {
+		std::shared_ptr<Element> element;
+		glm::vec2 min, max;
+		int node = -1;
+	};
+
+	struct Node {
+		glm::vec2 min, max;
+		int parent = -1;
+		int left = -1;
+		int right = -1;
+		// range into mItems for leaf nodes
+		std::size_t start = 0;
+		std::size_t count = 0;
+		bool isLeaf() const { return left < 0; }
+	};
+
+	void _collectRecursive( Group& aGroup, const glm::vec2& aOffset );
+	int _buildRecursive( std::size_t aStart, std::size_t aCount, int aParent );
+	void _refitNode( int aNodeIndex );
+
+	static float _distanceSquared( const glm::vec2& aPoint, const glm::vec2& aMin, const glm::vec2& aMax );
+
+	static const std::size_t sMaxItemsPerLeaf = 4;
+
+	std::vector<Item> mItems;
+	std::vector<Node> mNodes;
+	std::unordered_map< Element*, std::size_t > mItemForElement;
+	// reused between queries to avoid allocating
+	std::vector<int> mStack;
+};
+}
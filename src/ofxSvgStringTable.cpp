@@ -0,0 +1,76 @@
+//
+//  ofxSvgStringTable.cpp
+//
+
+#include "ofxSvgStringTable.h"
+
+using namespace ofx::svg;
+
+//--------------------------------------------------------------
+StringTable::StringTable() {
+	clear();
+}
+
+//--------------------------------------------------------------
+StringTable::StringTable( const StringTable& aOther ) {
+	*this = aOther;
+}
+
+//--------------------------------------------------------------
+StringTable& StringTable::operator=( const StringTable& aOther ) {
+	if( this == &aOther ) {
+		return *this;
+	}
+	mStrings = aOther.mStrings;
+	mNumReferences = aOther.mNumReferences;
+	mNumBytes = aOther.mNumBytes;
+	mIds.clear();
+	mIds.reserve( mStrings.size() );
+	for( std::size_t i = 0; i < mStrings.size(); i++ ) {
+		mIds[ std::string_view( mStrings[i] ) ] = (uint32_t)i;
+	}
+	return *this;
+}
+
+//--------------------------------------------------------------
+uint32_t StringTable::intern( const std::string& aStr ) {
+	mNumReferences++;
+	auto it = mIds.find( std::string_view( aStr ));
+	if( it != mIds.end() ) {
+		return it->second;
+	}
+	uint32_t tid = (uint32_t)mStrings.size();
+	mStrings.push_back( aStr );
+	mIds[ std::string_view( mStrings.back() ) ] = tid;
+	mNumBytes += sizeof(std::string) + mStrings.back().capacity();
+	return tid;
+}
+
+//--------------------------------------------------------------
+uint32_t StringTable::find( const std::string& aStr ) const {
+	auto it = mIds.find( std::string_view( aStr ));
+	if( it == mIds.end() ) {
+		return INVALID_ID;
+	}
+	return it->second;
+}
+
+//--------------------------------------------------------------
+const std::string& StringTable::get( uint32_t aId ) const {
+	if( aId >= mStrings.size() ) {
+		return mStrings[EMPTY_ID];
+	}
+	return mStrings[aId];
+}
+
+//--------------------------------------------------------------
+void StringTable::clear() {
+	mIds.clear();
+	mStrings.clear();
+	mNumReferences = 0;
+	mNumBytes = 0;
+	// the empty string is always id 0
+	mStrings.push_back( "" );
+	mIds[ std::string_view( mStrings.back() ) ] = EMPTY_ID;
+	mNumBytes += sizeof(std::string);
+}
@@ -0,0 +1,51 @@
+//
+//  ofxSvgStringTable.h
+//
+//  Interned strings of a document. Each unique string is stored once and identified by a small
+//  integer id, so names and font families can be compared by id instead of by their characters.
+//
+
+#pragma once
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <cstdint>
+
+namespace ofx::svg {
+class StringTable {
+public:
+	// the empty string, also the id of strings that have not been interned
+	static const uint32_t EMPTY_ID = 0;
+	// returned by find when the string is not in the table
+	static const uint32_t INVALID_ID = UINT32_MAX;
+
+	StringTable();
+	// the lookup map is rebuilt over the copied strings, so the copy does not point into aOther
+	StringTable( const StringTable& aOther );
+	StringTable& operator=( const StringTable& aOther );
+
+	// adds the string if it is not in the table yet and returns its id
+	uint32_t intern( const std::string& aStr );
+	// INVALID_ID if the string has not been interned, does not add it
+	uint32_t find( const std::string& aStr ) const;
+	bool contains( const std::string& aStr ) const { return find( aStr ) != INVALID_ID; }
+	// the empty string for ids that are not in the table
+	const std::string& get( uint32_t aId ) const;
+
+	void clear();
+	// number of unique strings, including the empty string
+	std::size_t size() const { return mStrings.size(); }
+	// calls to intern, the references to the strings in the document
+	std::size_t getNumReferences() const { return mNumReferences; }
+	// characters and string objects held by the table, not counting the lookup map
+	std::size_t getNumBytes() const { return mNumBytes; }
+
+protected:
+	// a deque, so the views in the lookup map stay valid as strings are added
+	std::deque<std::string> mStrings;
+	std::unordered_map< std::string_view, uint32_t > mIds;
+	std::size_t mNumReferences = 0;
+	std::size_t mNumBytes = 0;
+};
+}
@@ -0,0 +1,246 @@
+//
+//  ofxSvgStrokeTessellator.cpp
+//
+
+#include "ofxSvgStrokeTessellator.h"
+#include "ofMath.h"
+#include <cmath>
+#include <limits>
+
+using namespace ofx::svg;
+using std::string;
+using std::vector;
+
+// points closer than this are merged, so every segment has a direction
+static const float sMinSegmentLength = 1e-5f;
+
+//--------------------------------------------------------------
+void StrokeStyle::setLineJoin( const string& aValue ) {
+	if( aValue == "miter" || aValue == "miter-clip" || aValue == "arcs" ) {
+		lineJoin = STROKE_JOIN_MITER;
+	} else if( aValue == "round" ) {
+		lineJoin = STROKE_JOIN_ROUND;
+	} else if( aValue == "bevel" ) {
+		lineJoin = STROKE_JOIN_BEVEL;
+	}
+}
+
+//--------------------------------------------------------------
+void StrokeStyle::setLineCap( const string& aValue ) {
+	if( aValue == "butt" ) {
+		lineCap = STROKE_CAP_BUTT;
+	} else if( aValue == "round" ) {
+		lineCap = STROKE_CAP_ROUND;
+	} else if( aValue == "square" ) {
+		lineCap = STROKE_CAP_SQUARE;
+	}
+}
+
+//--------------------------------------------------------------
+void StrokeTessellator::sTessellate( const vector<ofPolyline>& aOutlines, float aWidth, const StrokeStyle& aStyle, ofMesh& aMesh, float aTolerance ) {
+	for( auto& outline : aOutlines ) {
+		sTessellate( outline, aWidth, aStyle, aMesh, aTolerance );
+	}
+}
+
+//--------------------------------------------------------------
+void StrokeTessellator::sTessellate( const ofPolyline& aOutline, float aWidth, const StrokeStyle& aStyle, ofMesh& aMesh, float aTolerance ) {
+	float hw = aWidth * 0.5f;
+	if( hw <= 0.f ) return;
+	aTolerance = std::max( aTolerance, 0.0001f );
+
+	vector<glm::vec2> tpoints;
+	tpoints.reserve( aOutline.size() );
+	for( auto& v : aOutline.getVertices() ) {
+		glm::vec2 tp( v.x, v.y );
+		if( tpoints.empty() || glm::length( tp - tpoints.back() ) > sMinSegmentLength ) {
+			tpoints.push_back( tp );
+		}
+	}
+	bool bClosed = aOutline.isClosed();
+	if( bClosed && tpoints.size() > 1 && glm::length( tpoints.front() - tpoints.back() ) <= sMinSegmentLength ) {
+		tpoints.pop_back();
+	}
+	std::size_t numPoints = tpoints.size();
+	if( numPoints < 1 ) return;
+
+	if( numPoints == 1 ) {
+		// zero length subpaths only draw round and square caps
+		if( bClosed ) return;
+		const auto& p = tpoints[0];
+		if( aStyle.lineCap == STROKE_CAP_ROUND ) {
+			ofIndexType tcenter = _sAddVertex( aMesh, p );
+			vector<ofIndexType> tarc;
+			_sAddArc( aMesh, p, glm::vec2( hw, 0.f ), TWO_PI, aTolerance, tarc );
+			_sAddFan( aMesh, tcenter, tarc );
+		} else if( aStyle.lineCap == STROKE_CAP_SQUARE ) {
+			ofIndexType i0 = _sAddVertex( aMesh, p + glm::vec2( -hw, -hw ));
+			ofIndexType i1 = _sAddVertex( aMesh, p + glm::vec2( hw, -hw ));
+			ofIndexType i2 = _sAddVertex( aMesh, p + glm::vec2( hw, hw ));
+			ofIndexType i3 = _sAddVertex( aMesh, p + glm::vec2( -hw, hw ));
+			aMesh.addIndices({ i0, i1, i2, i0, i2, i3 });
+		}
+		return;
+	}
+
+	std::size_t numSegments = bClosed ? numPoints : numPoints - 1;
+	vector<glm::vec2> tdirs( numSegments );
+	vector<float> tlengths( numSegments );
+	for( std::size_t i = 0; i < numSegments; i++ ) {
+		glm::vec2 td = tpoints[ (i + 1) % numPoints ] - tpoints[i];
+		tlengths[i] = glm::length( td );
+		tdirs[i] = td / tlengths[i];
+	}
+
+	// the vertices on the left and right of each point where the segment before ends and the one after starts.
+	// Left is the side of the normal ( -dir.y, dir.x ).
+	struct Join {
+		ofIndexType startLeft = 0;
+		ofIndexType startRight = 0;
+		ofIndexType endLeft = 0;
+		ofIndexType endRight = 0;
+	};
+	vector<Join> tjoins( numPoints );
+
+	for( std::size_t i = 0; i < numPoints; i++ ) {
+		const auto& p = tpoints[i];
+		auto& tjoin = tjoins[i];
+
+		if( !bClosed && ( i == 0 || i == numPoints - 1 )) {
+			bool bStart = ( i == 0 );
+			const auto& d = bStart ? tdirs.front() : tdirs.back();
+			glm::vec2 n( -d.y, d.x );
+			ofIndexType tleft, tright;
+			if( aStyle.lineCap == STROKE_CAP_ROUND ) {
+				ofIndexType tcenter = _sAddVertex( aMesh, p );
+				vector<ofIndexType> tarc;
+				// half circle around the back of the start or the front of the end
+				_sAddArc( aMesh, p, bStart ? n * hw : -n * hw, PI, aTolerance, tarc );
+				_sAddFan( aMesh, tcenter, tarc );
+				tleft = bStart ? tarc.front() : tarc.back();
+				tright = bStart ? tarc.back() : tarc.front();
+			} else {
+				glm::vec2 tshift( 0.f, 0.f );
+				if( aStyle.lineCap == STROKE_CAP_SQUARE ) {
+					tshift = ( bStart ? -d : d ) * hw;
+				}
+				tleft = _sAddVertex( aMesh, p + n * hw + tshift );
+				tright = _sAddVertex( aMesh, p - n * hw + tshift );
+			}
+			tjoin.startLeft = tjoin.endLeft = tleft;
+			tjoin.startRight = tjoin.endRight = tright;
+			continue;
+		}
+
+		std::size_t inIndex = ( i + numSegments - 1 ) % numSegments;
+		std::size_t outIndex = i % numSegments;
+		const auto& d0 = tdirs[inIndex];
+		const auto& d1 = tdirs[outIndex];
+		glm::vec2 n0( -d0.y, d0.x );
+		glm::vec2 n1( -d1.y, d1.x );
+		float tcross = d0.x * d1.y - d0.y * d1.x;
+		float tdot = glm::dot( d0, d1 );
+
+		if( std::fabs( tcross ) < 1e-6f && tdot > 0.f ) {
+			// straight, the segments share the edge
+			tjoin.startLeft = tjoin.endLeft = _sAddVertex( aMesh, p + n0 * hw );
+			tjoin.startRight = tjoin.endRight = _sAddVertex( aMesh, p - n0 * hw );
+			continue;
+		}
+
+		// the outside of the turn, +1 for the left
+		float tout = tcross > 0.f ? -1.f : 1.f;
+		glm::vec2 tmid = n0 + n1;
+		float tmidLen2 = glm::dot( tmid, tmid );
+		bool bHasMiter = tmidLen2 > 1e-8f;
+		// offset to the miter point for a half width of 1, its length is the miter length over the stroke width
+		glm::vec2 tmiter = bHasMiter ? tmid * ( 2.f / tmidLen2 ) : glm::vec2( 0.f, 0.f );
+		float tmiterRatio = bHasMiter ? glm::length( tmiter ) : std::numeric_limits<float>::max();
+		// the inner offset lines only meet inside of both segments when the turn is not too sharp for their lengths
+		bool bInnerMiter = bHasMiter && tmiterRatio * hw <= std::min( tlengths[inIndex], tlengths[outIndex] );
+		bool bOuterMiter = aStyle.lineJoin == STROKE_JOIN_MITER && bHasMiter && tmiterRatio <= aStyle.miterLimit;
+
+		vector<ofIndexType> touter;
+		if( bOuterMiter && bInnerMiter ) {
+			touter.push_back( _sAddVertex( aMesh, p + tmiter * ( tout * hw )));
+		} else {
+			glm::vec2 tfrom = n0 * ( tout * hw );
+			glm::vec2 tto = n1 * ( tout * hw );
+			if( aStyle.lineJoin == STROKE_JOIN_ROUND ) {
+				float tangle = std::atan2( tfrom.x * tto.y - tfrom.y * tto.x, glm::dot( tfrom, tto ));
+				if( !bHasMiter ) {
+					// turning back on itself, go around the front
+					glm::vec2 tfront( -tfrom.y, tfrom.x );
+					tangle = glm::dot( tfront, d0 ) > 0.f ? PI : -PI;
+				}
+				_sAddArc( aMesh, p, tfrom, tangle, aTolerance, touter );
+			} else {
+				touter.push_back( _sAddVertex( aMesh, p + tfrom ));
+				if( bOuterMiter ) {
+					touter.push_back( _sAddVertex( aMesh, p + tmiter * ( tout * hw )));
+				}
+				touter.push_back( _sAddVertex( aMesh, p + tto ));
+			}
+		}
+
+		ofIndexType tinnerIn, tinnerOut;
+		if( bInnerMiter ) {
+			tinnerIn = tinnerOut = _sAddVertex( aMesh, p - tmiter * ( tout * hw ));
+			// the join is the area between the inner point and the outer points
+			_sAddFan( aMesh, tinnerIn, touter );
+		} else {
+			tinnerIn = _sAddVertex( aMesh, p - n0 * ( tout * hw ));
+			tinnerOut = _sAddVertex( aMesh, p - n1 * ( tout * hw ));
+			// the segments end at their perpendiculars, fill around the point.
+			// The inner wedge overlaps the segments.
+			ofIndexType tcenter = _sAddVertex( aMesh, p );
+			_sAddFan( aMesh, tcenter, touter );
+			aMesh.addIndices({ tcenter, tinnerOut, tinnerIn });
+		}
+
+		if( tout > 0.f ) {
+			tjoin.endLeft = touter.front();
+			tjoin.startLeft = touter.back();
+			tjoin.endRight = tinnerIn;
+			tjoin.startRight = tinnerOut;
+		} else {
+			tjoin.endRight = touter.front();
+			tjoin.startRight = touter.back();
+			tjoin.endLeft = tinnerIn;
+			tjoin.startLeft = tinnerOut;
+		}
+	}
+
+	// the segments go from where the previous join ends to where the next one starts
+	for( std::size_t i = 0; i < numSegments; i++ ) {
+		const auto& ta = tjoins[i];
+		const auto& tb = tjoins[ (i + 1) % numPoints ];
+		aMesh.addIndices({ ta.startLeft, ta.startRight, tb.endRight, ta.startLeft, tb.endRight, tb.endLeft });
+	}
+}
+
+//--------------------------------------------------------------
+void StrokeTessellator::_sAddArc( ofMesh& aMesh, const glm::vec2& aCenter, const glm::vec2& aFrom, float aAngle, float aTolerance, vector<ofIndexType>& aIndices ) {
+	float tradius = glm::length( aFrom );
+	// angle of a segment whose midpoint is aTolerance away from the arc
+	float tstep = tradius > aTolerance ? 2.f * std::acos( 1.f - aTolerance / tradius ) : HALF_PI;
+	int numSegments = (int)ofClamp( std::ceil( std::fabs( aAngle ) / std::max( tstep, 0.0001f )), 1.f, 128.f );
+	float tstart = std::atan2( aFrom.y, aFrom.x );
+	for( int k = 0; k <= numSegments; k++ ) {
+		float ta = tstart + aAngle * (float)k / (float)numSegments;
+		aIndices.push_back( _sAddVertex( aMesh, aCenter + glm::vec2( std::cos( ta ), std::sin( ta )) * tradius ));
+	}
+}
+
+//--------------------------------------------------------------
+ofIndexType StrokeTessellator::_sAddVertex( ofMesh& aMesh, const glm::vec2& aPoint ) {
+	aMesh.addVertex( glm::vec3( aPoint.x, aPoint.y, 0.f ));
+	return (ofIndexType)( aMesh.getNumVertices() - 1 );
+}
+
+//--------------------------------------------------------------
+void StrokeTessellator::_sAddFan( ofMesh& aMesh, ofIndexType aCenter, const vector<ofIndexType>& aIndices ) {
+	for( std::size_t k = 0; k + 1 < aIndices.size(); k++ ) {
+		aMesh.addIndices({ aCenter, aIndices[k], aIndices[k + 1] });
+	}
+}
@@ -0,0 +1,57 @@
+//
+//  ofxSvgStrokeTessellator.h
+//
+//  Expands polylines into triangles that cover their stroke, with the joins, caps and miter
+//  limit of the svg stroke properties. Unlike gl lines the width is honored on every renderer.
+//
+
+#pragma once
+#include "ofPolyline.h"
+#include "ofMesh.h"
+
+namespace ofx::svg {
+enum StrokeLineJoin {
+	STROKE_JOIN_MITER = 0,
+	STROKE_JOIN_ROUND,
+	STROKE_JOIN_BEVEL
+};
+
+enum StrokeLineCap {
+	STROKE_CAP_BUTT = 0,
+	STROKE_CAP_ROUND,
+	STROKE_CAP_SQUARE
+};
+
+class StrokeStyle {
+public:
+	// svg defaults
+	StrokeLineJoin lineJoin = STROKE_JOIN_MITER;
+	StrokeLineCap lineCap = STROKE_CAP_BUTT;
+	// ratio of the miter length to the stroke width, longer miters are beveled
+	float miterLimit = 4.f;
+
+	bool operator==( const StrokeStyle& aOther ) const {
+		return lineJoin == aOther.lineJoin && lineCap == aOther.lineCap && miterLimit == aOther.miterLimit;
+	}
+	bool operator!=( const StrokeStyle& aOther ) const { return !( *this == aOther ); }
+
+	// parses the values of stroke-linejoin and stroke-linecap, keeping the current value for unknown strings
+	void setLineJoin( const std::string& aValue );
+	void setLineCap( const std::string& aValue );
+};
+
+class StrokeTessellator {
+public:
+	// appends indexed triangles for the strokes of the outlines to aMesh.
+	// Round joins and caps are split into segments that deviate at most aTolerance from the arc.
+	// The triangles of one outline only overlap where it crosses itself and inside of sharp turns between short segments.
+	static void sTessellate( const std::vector<ofPolyline>& aOutlines, float aWidth, const StrokeStyle& aStyle, ofMesh& aMesh, float aTolerance = 0.1f );
+	static void sTessellate( const ofPolyline& aOutline, float aWidth, const StrokeStyle& aStyle, ofMesh& aMesh, float aTolerance = 0.1f );
+
+protected:
+	// adds the points of the arc from aCenter + aFrom, rotated by aAngle, including both ends
+	static void _sAddArc( ofMesh& aMesh, const glm::vec2& aCenter, const glm::vec2& aFrom, float aAngle, float aTolerance, std::vector<ofIndexType>& aIndices );
+	static ofIndexType _sAddVertex( ofMesh& aMesh, const glm::vec2& aPoint );
+	static void _sAddFan( ofMesh& aMesh, ofIndexType aCenter, const std::vector<ofIndexType>& aIndices );
+};
+}
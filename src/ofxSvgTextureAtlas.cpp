@@ -0,0 +1,130 @@
+//
+//  ofxSvgTextureAtlas.cpp
+//
+
+#include "ofxSvgTextureAtlas.h"
+#include "ofLog.h"
+#include <cstring>
+
+using namespace ofx::svg;
+using std::shared_ptr;
+
+//--------------------------------------------------------------
+ofTexture* TextureAtlas::Page::getTexture() {
+	if( !mBUploaded ) {
+		mTexture.allocate( mPixels );
+		mBUploaded = true;
+	}
+	return &mTexture;
+}
+
+//--------------------------------------------------------------
+void TextureAtlas::setup( int aPageSize, int aPadding ) {
+	clear();
+	mPageSize = std::max( 1, aPageSize );
+	mPadding = std::max( 0, aPadding );
+}
+
+//--------------------------------------------------------------
+void TextureAtlas::clear() {
+	// pages still referenced by images stay alive until those are released
+	mPages.clear();
+}
+
+//--------------------------------------------------------------
+bool TextureAtlas::add( const ofPixels& aPixels, shared_ptr<Page>& aPage, ofRectangle& aRect ) {
+	int w = (int)aPixels.getWidth();
+	int h = (int)aPixels.getHeight();
+	if( w < 1 || h < 1 ) {
+		return false;
+	}
+	if( w + mPadding * 2 > mPageSize || h + mPadding * 2 > mPageSize ) {
+		ofLogVerbose(moduleName()) << __FUNCTION__ << " : " << w << " x " << h << " is too large for a page of " << mPageSize;
+		return false;
+	}
+
+	int tx = 0;
+	int ty = 0;
+	shared_ptr<Page> tpage;
+	if( mPages.size() && _fitOnPage( *mPages.back(), w, h, tx, ty )) {
+		tpage = mPages.back();
+	} else {
+		tpage = _addPage();
+		_fitOnPage( *tpage, w, h, tx, ty );
+	}
+
+	// the pages are rgba, so convert anything else first
+	if( aPixels.getNumChannels() != 4 ) {
+		ofPixels tconverted = aPixels;
+		tconverted.setImageType( OF_IMAGE_COLOR_ALPHA );
+		_copyWithPadding( tconverted, *tpage, tx, ty );
+	} else {
+		_copyWithPadding( aPixels, *tpage, tx, ty );
+	}
+	tpage->mBUploaded = false;
+
+	aPage = tpage;
+	aRect.set( tx, ty, w, h );
+	return true;
+}
+
+//--------------------------------------------------------------
+shared_ptr<TextureAtlas::Page> TextureAtlas::_addPage() {
+	auto tpage = std::make_shared<Page>();
+	tpage->mWidth = mPageSize;
+	tpage->mHeight = mPageSize;
+	tpage->mPixels.allocate( mPageSize, mPageSize, OF_IMAGE_COLOR_ALPHA );
+	tpage->mPixels.set( 0 );
+	mPages.push_back( tpage );
+	return tpage;
+}
+
+//--------------------------------------------------------------
+bool TextureAtlas::_fitOnPage( Page& aPage, int aWidth, int aHeight, int& aX, int& aY ) {
+	int pw = aWidth + mPadding * 2;
+	int ph = aHeight + mPadding * 2;
+	// start a new shelf below the current one when the row is full
+	if( aPage.mShelfX + pw > aPage.mWidth ) {
+		aPage.mShelfY += aPage.mShelfHeight;
+		aPage.mShelfX = 0;
+		aPage.mShelfHeight = 0;
+	}
+	if( aPage.mShelfY + ph > aPage.mHeight ) {
+		return false;
+	}
+	aX = aPage.mShelfX + mPadding;
+	aY = aPage.mShelfY + mPadding;
+	aPage.mShelfX += pw;
+	aPage.mShelfHeight = std::max( aPage.mShelfHeight, ph );
+	return true;
+}
+
+//--------------------------------------------------------------
+void TextureAtlas::_copyWithPadding( const ofPixels& aSrc, Page& aPage, int aX, int aY ) {
+	int w = (int)aSrc.getWidth();
+	int h = (int)aSrc.getHeight();
+	const std::size_t bpp = 4;
+	std::size_t dstStride = (std::size_t)aPage.mWidth * bpp;
+	std::size_t srcStride = (std::size_t)w * bpp;
+	unsigned char* dst = aPage.mPixels.getData();
+	const unsigned char* src = aSrc.getData();
+	if( !dst || !src ) return;
+
+	for( int y = 0; y < h; y++ ) {
+		unsigned char* drow = dst + (std::size_t)(aY + y) * dstStride;
+		const unsigned char* srow = src + (std::size_t)y * srcStride;
+		memcpy( drow + (std::size_t)aX * bpp, srow, srcStride );
+		// repeat the first and last pixels of the row into the padding
+		for( int p = 1; p <= mPadding; p++ ) {
+			memcpy( drow + (std::size_t)(aX - p) * bpp, srow, bpp );
+			memcpy( drow + (std::size_t)(aX + w - 1 + p) * bpp, srow + (std::size_t)(w - 1) * bpp, bpp );
+		}
+	}
+	// and the first and last rows, including the padding columns
+	std::size_t paddedRowBytes = (std::size_t)(w + mPadding * 2) * bpp;
+	std::size_t rowStart = (std::size_t)(aX - mPadding) * bpp;
+	for( int p = 1; p <= mPadding; p++ ) {
+		memcpy( dst + (std::size_t)(aY - p) * dstStride + rowStart, dst + (std::size_t)aY * dstStride + rowStart, paddedRowBytes );
+		memcpy( dst + (std::size_t)(aY + h - 1 + p) * dstStride + rowStart, dst + (std::size_t)(aY + h - 1) * dstStride + rowStart, paddedRowBytes );
+	}
+}
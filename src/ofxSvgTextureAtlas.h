@@ -0,0 +1,62 @@
+//
+//  ofxSvgTextureAtlas.h
+//
+//  Packs small images into shared rgba pages with a shelf packer, so that images
+//  using different files can be drawn with a single texture bind.
+//
+
+#pragma once
+#include "ofPixels.h"
+#include "ofTexture.h"
+#include "ofRectangle.h"
+
+namespace ofx::svg {
+class TextureAtlas {
+public:
+	class Page {
+	public:
+		int getWidth() { return mWidth; }
+		int getHeight() { return mHeight; }
+		bool isUploaded() { return mBUploaded; }
+		const ofPixels& getPixels() { return mPixels; }
+		// uploads the pixels on the first call, must be called from the gl thread
+		ofTexture* getTexture();
+
+	protected:
+		friend class TextureAtlas;
+		int mWidth = 0;
+		int mHeight = 0;
+		ofPixels mPixels;
+		ofTexture mTexture;
+		bool mBUploaded = false;
+		// current shelf that images are added to, left to right
+		int mShelfX = 0;
+		int mShelfY = 0;
+		int mShelfHeight = 0;
+	};
+
+	// aPadding pixels around each image are filled with its edge pixels to avoid bleeding when filtering
+	void setup( int aPageSize = 2048, int aPadding = 2 );
+	void clear();
+
+	// copies the pixels into a page, aRect is the area in the page in pixels.
+	// Returns false if the pixels are too large for a page.
+	// Adding images sorted by height, tallest first, packs them tighter.
+	bool add( const ofPixels& aPixels, std::shared_ptr<Page>& aPage, ofRectangle& aRect );
+
+	const std::vector< std::shared_ptr<Page> >& getPages() { return mPages; }
+	int getPageSize() { return mPageSize; }
+
+	// will log messages to this module name
+	static const std::string moduleName() { return "ofx::svg::TextureAtlas"; }
+
+protected:
+	std::shared_ptr<Page> _addPage();
+	bool _fitOnPage( Page& aPage, int aWidth, int aHeight, int& aX, int& aY );
+	void _copyWithPadding( const ofPixels& aSrc, Page& aPage, int aX, int aY );
+
+	int mPageSize = 2048;
+	int mPadding = 2;
+	std::vector< std::shared_ptr<Page> > mPages;
+};
+}
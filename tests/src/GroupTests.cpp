@@ -0,0 +1,163 @@
+//
+//  GroupTests.cpp
+//
+
+#include "GroupTests.h"
+
+using namespace ofx::svg;
+using std::make_shared;
+using std::shared_ptr;
+
+namespace {
+	// keeps the type tag of Path
+	class TaggedPath : public Path {
+	};
+	
+	//--------------------------------------------------------------
+	shared_ptr<Path> sCreateSquare( const std::string& aName, const glm::vec2& aPos, float aSize ) {
+		auto tpath = make_shared<Path>();
+		tpath->name = aName;
+		tpath->path.setFilled( true );
+		tpath->path.rectangle( aPos.x, aPos.y, aSize, aSize );
+		return tpath;
+	}
+
+	//--------------------------------------------------------------
+	bool sCheck( bool abPassed, const std::string& aTestName, const std::string& aMessage ) {
+		if( !abPassed ) {
+			ofLogError("GroupTests") << aTestName << " : " << aMessage;
+		}
+		return abPassed;
+	}
+}
+
+//--------------------------------------------------------------
+int GroupTests::sRunAll() {
+	int numFailed = 0;
+	if( !sTestCulledDrawAfterAppend() ) numFailed++;
+	if( !sTestCulledDrawWithKeptChildren() ) numFailed++;
+	if( !sTestLookupsAfterAppendAndRemove() ) numFailed++;
+	if( !sTestLookupsAfterNestedChange() ) numFailed++;
+	if( !sTestSubclassLookups() ) numFailed++;
+	if( !sTestNestedHitTest() ) numFailed++;
+	if( numFailed == 0 ) {
+		ofLogNotice("GroupTests") << "all group tests passed";
+	}
+	return numFailed;
+}
+
+//--------------------------------------------------------------
+bool GroupTests::sTestCulledDrawAfterAppend() {
+	ofRectangle tviewRect( 0, 0, 100, 100 );
+	Group tgroup;
+	tgroup.getChildren().push_back( sCreateSquare( "first", glm::vec2( 10.f, 10.f ), 20.f ));
+	tgroup.markChildrenChanged();
+	tgroup.draw( tviewRect );
+
+	tgroup.getChildren().push_back( sCreateSquare( "second", glm::vec2( 50.f, 50.f ), 20.f ));
+	tgroup.draw( tviewRect );
+	return sCheck( tgroup.getNumDrawnElements() == 2, __FUNCTION__, "drew " + ofToString( tgroup.getNumDrawnElements() ) + " of 2 elements" );
+}
+
+//--------------------------------------------------------------
+bool GroupTests::sTestCulledDrawWithKeptChildren() {
+	ofRectangle tviewRect( 0, 0, 100, 100 );
+	Group tgroup;
+	auto& tchildren = tgroup.getChildren();
+	tchildren.push_back( sCreateSquare( "first", glm::vec2( 10.f, 10.f ), 20.f ));
+	tgroup.draw( tviewRect );
+
+	tchildren.push_back( sCreateSquare( "second", glm::vec2( 50.f, 50.f ), 20.f ));
+	tchildren.push_back( sCreateSquare( "outside", glm::vec2( 500.f, 500.f ), 20.f ));
+	tgroup.draw( tviewRect );
+	// the outside square may or may not be culled, depending on whether the bounds were rebuilt
+	bool bPassed = sCheck( tgroup.getNumDrawnElements() + tgroup.getNumCulledElements() == 3 && tgroup.getNumDrawnElements() >= 2, __FUNCTION__, "drew " + ofToString( tgroup.getNumDrawnElements() ) + " and culled " + ofToString( tgroup.getNumCulledElements() ) + " of 3 elements" );
+
+	tgroup.markChildrenChanged();
+	tgroup.draw( tviewRect );
+	bPassed &= sCheck( tgroup.getNumDrawnElements() == 2 && tgroup.getNumCulledElements() == 1, __FUNCTION__, "after markChildrenChanged() drew " + ofToString( tgroup.getNumDrawnElements() ) + " and culled " + ofToString( tgroup.getNumCulledElements() ) + " of 3 elements" );
+	return bPassed;
+}
+
+//--------------------------------------------------------------
+bool GroupTests::sTestLookupsAfterAppendAndRemove() {
+	Group tgroup;
+	tgroup.setNameIndexEnabled( true );
+	tgroup.getChildren().push_back( sCreateSquare( "first", glm::vec2( 10.f, 10.f ), 20.f ));
+	bool bPassed = sCheck( tgroup.getElementForName( "first" ) != nullptr, __FUNCTION__, "did not find the first child" );
+	bPassed &= sCheck( tgroup.getElementsForType<Path>().size() == 1, __FUNCTION__, "the type bucket does not have the first child" );
+
+	tgroup.getChildren().push_back( sCreateSquare( "second", glm::vec2( 50.f, 50.f ), 20.f ));
+	bPassed &= sCheck( tgroup.getElementForName( "second" ) != nullptr, __FUNCTION__, "did not find the appended child" );
+	bPassed &= sCheck( tgroup.getElementsForType<Path>().size() == 2, __FUNCTION__, "the type bucket does not have the appended child" );
+	bPassed &= sCheck( tgroup.getAllElementsContainingName( "sec" ).size() == 1, __FUNCTION__, "the substring index does not have the appended child" );
+
+	std::weak_ptr<Element> tfirst = tgroup.getElementForName( "first" );
+	tgroup.getChildren().erase( tgroup.getChildren().begin() );
+	bPassed &= sCheck( tgroup.getElementForName( "first" ) == nullptr, __FUNCTION__, "found the removed child" );
+	bPassed &= sCheck( tgroup.getElementsForType<Path>().size() == 1, __FUNCTION__, "the type bucket still has the removed child" );
+	bPassed &= sCheck( tfirst.expired(), __FUNCTION__, "the removed child is still referenced" );
+	return bPassed;
+}
+
+//--------------------------------------------------------------
+bool GroupTests::sTestLookupsAfterNestedChange() {
+	Group troot;
+	troot.setNameIndexEnabled( true );
+	auto tnested = make_shared<Group>();
+	tnested->name = "nested";
+	troot.getChildren().push_back( tnested );
+	troot.getChildren().push_back( sCreateSquare( "first", glm::vec2( 10.f, 10.f ), 20.f ));
+	bool bPassed = sCheck( troot.getAllElementsForType<Path>().size() == 1, __FUNCTION__, "the type bucket does not have the first child" );
+
+	tnested->getChildren().push_back( sCreateSquare( "inner", glm::vec2( 50.f, 50.f ), 20.f ));
+	bPassed &= sCheck( troot.getElementForName( "nested:inner" ) != nullptr, __FUNCTION__, "did not find the child appended to the nested group" );
+	bPassed &= sCheck( troot.getAllElementsForType<Path>().size() == 2, __FUNCTION__, "the type bucket does not have the child of the nested group" );
+	bPassed &= sCheck( troot.hasBounds() && troot.getLocalBounds().getRight() >= 70.f, __FUNCTION__, "the bounds do not include the child of the nested group" );
+	return bPassed;
+}
+
+//--------------------------------------------------------------
+bool GroupTests::sTestSubclassLookups() {
+	Group tgroup;
+	tgroup.getChildren().push_back( sCreateSquare( "path", glm::vec2( 10.f, 10.f ), 20.f ));
+	auto ttagged = make_shared<TaggedPath>();
+	ttagged->name = "tagged";
+	tgroup.getChildren().push_back( ttagged );
+	
+	bool bPassed = sCheck( tgroup.getElementsForType<Path>().size() == 2, __FUNCTION__, "did not find both paths" );
+	auto ttaggedPaths = tgroup.getElementsForType<TaggedPath>();
+	bPassed &= sCheck( ttaggedPaths.size() == 1 && ttaggedPaths[0] == ttagged, __FUNCTION__, "did not find only the subclass" );
+	bPassed &= sCheck( tgroup.getFirstElementForType<TaggedPath>() == ttagged, __FUNCTION__, "the first element is not the subclass" );
+	
+	std::size_t numTagged = 0;
+	for( auto tpath : tgroup.getElementsForTypeView<TaggedPath>() ) {
+		if( tpath ) numTagged++;
+	}
+	bPassed &= sCheck( numTagged == 1, __FUNCTION__, "the view has " + ofToString( numTagged ) + " of 1 subclass elements" );
+	return bPassed;
+}
+
+//--------------------------------------------------------------
+bool GroupTests::sTestNestedHitTest() {
+	Group troot;
+	troot.pos = glm::vec2( 0.f, 50.f );
+	auto tnested = make_shared<Group>();
+	tnested->pos = glm::vec2( 100.f, 0.f );
+	auto tsquare = sCreateSquare( "square", glm::vec2( 10.f, 10.f ), 20.f );
+	tnested->getChildren().push_back( tsquare );
+	auto toutside = sCreateSquare( "outside", glm::vec2( 10.f, 10.f ), 20.f );
+	troot.getChildren().push_back( tnested );
+	troot.getChildren().push_back( toutside );
+	troot.markChildrenChanged();
+	
+	bool bPassed = sCheck( tnested->hitTest( glm::vec2( 120.f, 70.f )) == tsquare, __FUNCTION__, "missed the square of the nested group" );
+	bPassed &= sCheck( tnested->hitTest( glm::vec2( 20.f, 70.f )) == nullptr, __FUNCTION__, "hit an element outside of the nested group" );
+	bPassed &= sCheck( troot.hitTest( glm::vec2( 20.f, 70.f )) == toutside, __FUNCTION__, "the root missed its own square" );
+	
+	// removed through getChildren(), picked up by the next hit test
+	tnested->getChildren().clear();
+	bPassed &= sCheck( tnested->hitTest( glm::vec2( 120.f, 70.f )) == nullptr, __FUNCTION__, "hit a removed element" );
+	bPassed &= sCheck( troot.hitTest( glm::vec2( 120.f, 70.f )) == nullptr, __FUNCTION__, "the root hit a removed element" );
+	return bPassed;
+}
@@ -0,0 +1,28 @@
+//
+//  GroupTests.h
+//
+//  Checks of the cached lookups and culling of groups after the children change,
+//  run along with the render tests.
+//
+
+#pragma once
+#include "ofxSvgGroup.h"
+
+class GroupTests {
+public:
+	// runs all of the tests and logs the failures, returns the number of tests that failed
+	static int sRunAll();
+
+	// appends a child through getChildren() without markChildrenChanged() and draws culled
+	static bool sTestCulledDrawAfterAppend();
+	// same, with a reference to the children kept from before the first draw
+	static bool sTestCulledDrawWithKeptChildren();
+	// the name index and type buckets pick up children added and removed through getChildren()
+	static bool sTestLookupsAfterAppendAndRemove();
+	// same, for the children of a nested group
+	static bool sTestLookupsAfterNestedChange();
+	// lookups by type for a subclass of Path that shares its type tag
+	static bool sTestSubclassLookups();
+	// hit testing on a nested group, with the points in document space
+	static bool sTestNestedHitTest();
+};
@@ -0,0 +1,222 @@
+//
+//  RenderScenes.cpp
+//
+
+#include "RenderScenes.h"
+
+using namespace ofx::svg;
+using std::make_shared;
+using std::shared_ptr;
+using std::vector;
+
+namespace {
+	//--------------------------------------------------------------
+	RenderScene sCreateScene( const std::string& aName, int aWidth, int aHeight ) {
+		RenderScene tscene;
+		tscene.name = aName;
+		tscene.root = make_shared<Group>();
+		tscene.viewRect.set( 0, 0, aWidth, aHeight );
+		tscene.width = aWidth;
+		tscene.height = aHeight;
+		return tscene;
+	}
+	
+	//--------------------------------------------------------------
+	void sAddChild( RenderScene& aScene, shared_ptr<Element> aElement ) {
+		aScene.root->getChildren().push_back( aElement );
+		aScene.root->markChildrenChanged();
+	}
+	
+	//--------------------------------------------------------------
+	void sAddOutline( ofPath& aPath, const vector<glm::vec2>& aPoints, bool abClose ) {
+		for( std::size_t i = 0; i < aPoints.size(); i++ ) {
+			if( i == 0 ) {
+				aPath.moveTo( glm::vec3( aPoints[i], 0.f ));
+			} else {
+				aPath.lineTo( glm::vec3( aPoints[i], 0.f ));
+			}
+		}
+		if( abClose ) {
+			aPath.close();
+		}
+	}
+	
+	//--------------------------------------------------------------
+	vector<glm::vec2> sGetStar( const glm::vec2& aCenter, float aRadius ) {
+		// connects every second point of a pentagon, so the center is wound twice
+		vector<glm::vec2> tpoints;
+		for( int i = 0; i < 5; i++ ) {
+			float tangle = glm::radians( -90.f + 144.f * (float)i );
+			tpoints.push_back( aCenter + glm::vec2( cosf( tangle ), sinf( tangle )) * aRadius );
+		}
+		return tpoints;
+	}
+	
+	//--------------------------------------------------------------
+	vector<glm::vec2> sGetSquare( const glm::vec2& aCenter, float aHalfSize ) {
+		return {
+			aCenter + glm::vec2( -aHalfSize, -aHalfSize ),
+			aCenter + glm::vec2( aHalfSize, -aHalfSize ),
+			aCenter + glm::vec2( aHalfSize, aHalfSize ),
+			aCenter + glm::vec2( -aHalfSize, aHalfSize )
+		};
+	}
+	
+	//--------------------------------------------------------------
+	shared_ptr<Path> sCreateFilledPath( const ofColor& aColor, ofPolyWindingMode aWindingMode ) {
+		auto tpath = make_shared<Path>();
+		tpath->path.setFilled( true );
+		tpath->path.setFillColor( aColor );
+		tpath->path.setStrokeWidth( 0.f );
+		tpath->path.setPolyWindingMode( aWindingMode );
+		return tpath;
+	}
+	
+	//--------------------------------------------------------------
+	shared_ptr<Path> sCreateStrokedPath( const ofColor& aColor, float aWidth ) {
+		auto tpath = make_shared<Path>();
+		tpath->path.setFilled( false );
+		tpath->path.setStrokeColor( aColor );
+		tpath->path.setStrokeWidth( aWidth );
+		return tpath;
+	}
+}
+
+//--------------------------------------------------------------
+vector<RenderScene> RenderScene::sCreateAll( const of::filesystem::path& aDataPath ) {
+	return {
+		sCreateFillRules(),
+		sCreateStrokes(),
+		sCreateImages( aDataPath ),
+		sCreateText( aDataPath )
+	};
+}
+
+//--------------------------------------------------------------
+RenderScene RenderScene::sCreateFillRules() {
+	auto tscene = sCreateScene( "fill_rules", 200, 200 );
+	
+	// the center of the star is empty with even odd and filled with non zero
+	auto tstarOdd = sCreateFilledPath( ofColor( 230, 60, 40 ), OF_POLY_WINDING_ODD );
+	sAddOutline( tstarOdd->path, sGetStar( glm::vec2( 50.f, 55.f ), 45.f ), true );
+	sAddChild( tscene, tstarOdd );
+	
+	auto tstarNonZero = sCreateFilledPath( ofColor( 40, 120, 230 ), OF_POLY_WINDING_NONZERO );
+	sAddOutline( tstarNonZero->path, sGetStar( glm::vec2( 150.f, 55.f ), 45.f ), true );
+	sAddChild( tscene, tstarNonZero );
+	
+	// nested squares wound the same way, the inner one is a hole with even odd only
+	auto tsquaresOdd = sCreateFilledPath( ofColor( 30, 160, 90 ), OF_POLY_WINDING_ODD );
+	sAddOutline( tsquaresOdd->path, sGetSquare( glm::vec2( 50.f, 150.f ), 40.f ), true );
+	sAddOutline( tsquaresOdd->path, sGetSquare( glm::vec2( 50.f, 150.f ), 20.f ), true );
+	sAddChild( tscene, tsquaresOdd );
+	
+	auto tsquaresNonZero = sCreateFilledPath( ofColor( 240, 170, 20 ), OF_POLY_WINDING_NONZERO );
+	sAddOutline( tsquaresNonZero->path, sGetSquare( glm::vec2( 150.f, 150.f ), 40.f ), true );
+	sAddOutline( tsquaresNonZero->path, sGetSquare( glm::vec2( 150.f, 150.f ), 20.f ), true );
+	// a translucent overlap to check the blending
+	auto toverlap = sCreateFilledPath( ofColor( 120, 40, 200, 128 ), OF_POLY_WINDING_ODD );
+	sAddOutline( toverlap->path, sGetSquare( glm::vec2( 100.f, 100.f ), 25.f ), true );
+	sAddChild( tscene, tsquaresNonZero );
+	sAddChild( tscene, toverlap );
+	return tscene;
+}
+
+//--------------------------------------------------------------
+RenderScene RenderScene::sCreateStrokes() {
+	auto tscene = sCreateScene( "strokes", 200, 200 );
+	
+	// an open zigzag with thin and wide strokes, drawn with the default round joins
+	auto tthin = sCreateStrokedPath( ofColor( 20, 20, 20 ), 1.f );
+	sAddOutline( tthin->path, { { 10.f, 30.f }, { 50.f, 10.f }, { 90.f, 30.f }, { 130.f, 10.f }, { 190.f, 30.f }}, false );
+	sAddChild( tscene, tthin );
+	
+	auto twide = sCreateStrokedPath( ofColor( 200, 50, 50 ), 8.f );
+	sAddOutline( twide->path, { { 10.f, 70.f }, { 50.f, 50.f }, { 90.f, 70.f }, { 130.f, 50.f }, { 190.f, 70.f }}, false );
+	sAddChild( tscene, twide );
+	
+	// tessellated strokes with each join and cap
+	StrokeLineJoin tjoins[3] = { STROKE_JOIN_MITER, STROKE_JOIN_ROUND, STROKE_JOIN_BEVEL };
+	StrokeLineCap tcaps[3] = { STROKE_CAP_BUTT, STROKE_CAP_ROUND, STROKE_CAP_SQUARE };
+	for( int i = 0; i < 3; i++ ) {
+		float tx = 20.f + 60.f * (float)i;
+		auto tpath = sCreateStrokedPath( ofColor( 40, 90, 200 ), 10.f );
+		sAddOutline( tpath->path, { { tx, 150.f }, { tx + 20.f, 100.f }, { tx + 40.f, 150.f }}, false );
+		StrokeStyle tstyle;
+		tstyle.lineJoin = tjoins[i];
+		tstyle.lineCap = tcaps[i];
+		tpath->setStrokeStyle( tstyle );
+		tpath->setStrokeTessellationEnabled( true );
+		sAddChild( tscene, tpath );
+	}
+	
+	// filled and stroked, the stroke is drawn over the fill
+	auto tboth = sCreateFilledPath( ofColor( 250, 210, 60 ), OF_POLY_WINDING_ODD );
+	tboth->path.setStrokeColor( ofColor( 60, 40, 20 ));
+	tboth->path.setStrokeWidth( 4.f );
+	sAddOutline( tboth->path, sGetSquare( glm::vec2( 100.f, 180.f ), 12.f ), true );
+	sAddChild( tscene, tboth );
+	return tscene;
+}
+
+//--------------------------------------------------------------
+RenderScene RenderScene::sCreateImages( const of::filesystem::path& aDataPath ) {
+	auto tscene = sCreateScene( "images", 200, 200 );
+	auto tfilepath = aDataPath / "images" / "checker.png";
+	
+	auto timage = make_shared<Image>();
+	timage->filepath = tfilepath;
+	timage->pos = glm::vec2( 10.f, 10.f );
+	timage->width = 32.f;
+	timage->height = 32.f;
+	timage->setUseShapeColor( false );
+	sAddChild( tscene, timage );
+	
+	// scaled up, so the filtering between the pixels is tested
+	auto tscaled = make_shared<Image>();
+	tscaled->filepath = tfilepath;
+	tscaled->pos = glm::vec2( 60.f, 10.f );
+	tscaled->scale = glm::vec2( 3.5f, 2.5f );
+	tscaled->width = 32.f;
+	tscaled->height = 32.f;
+	tscaled->setUseShapeColor( false );
+	sAddChild( tscene, tscaled );
+	
+	// rotated and tinted by the shape color
+	auto trotated = make_shared<Image>();
+	trotated->filepath = tfilepath;
+	trotated->pos = glm::vec2( 60.f, 110.f );
+	trotated->rotation = 30.f;
+	trotated->scale = glm::vec2( 2.f, 2.f );
+	trotated->width = 32.f;
+	trotated->height = 32.f;
+	trotated->setColor( ofColor( 255, 160, 160, 200 ));
+	sAddChild( tscene, trotated );
+	return tscene;
+}
+
+//--------------------------------------------------------------
+RenderScene RenderScene::sCreateText( const of::filesystem::path& aDataPath ) {
+	auto tscene = sCreateScene( "text", 240, 120 );
+	tscene.tolerance = 24;
+	tscene.maxDifferentFraction = 0.01f;
+	
+	auto tfontPath = ( aDataPath / "fonts" / "DejaVuSansMono.ttf" ).string();
+	auto taddText = [&]( const std::string& aString, int aFontSize, const ofColor& aColor, const glm::vec2& aPos, float aRotation ) {
+		auto ttext = make_shared<Text>();
+		ttext->pos = aPos;
+		ttext->rotation = aRotation;
+		auto tspan = make_shared<Text::TextSpan>();
+		tspan->text = aString;
+		tspan->fontSize = aFontSize;
+		// a family that is not in the font index is used as the path of the font file
+		tspan->fontFamily = tfontPath;
+		tspan->color = aColor;
+		ttext->textSpans.push_back( tspan );
+		sAddChild( tscene, ttext );
+	};
+	taddText( "Hello svg", 24, ofColor( 20, 20, 20 ), glm::vec2( 10.f, 34.f ), 0.f );
+	taddText( "12px, kerning AV To", 12, ofColor( 200, 40, 40 ), glm::vec2( 10.f, 60.f ), 0.f );
+	taddText( "rotated", 18, ofColor( 40, 90, 200 ), glm::vec2( 120.f, 80.f ), 20.f );
+	return tscene;
+}
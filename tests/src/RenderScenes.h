@@ -0,0 +1,30 @@
+//
+//  RenderScenes.h
+//
+//  Documents rendered by the pixel-diff tests. They are built in code instead of parsed,
+//  so a difference points at the renderer and not at the parser.
+//
+
+#pragma once
+#include "ofxSvgGroup.h"
+
+class RenderScene {
+public:
+	std::string name;
+	std::shared_ptr<ofx::svg::Group> root;
+	ofRectangle viewRect;
+	int width = 0;
+	int height = 0;
+	// pixels with a channel that differs from the reference by more than the tolerance are counted as different
+	int tolerance = 2;
+	// fraction of the pixels that may be different, glyphs vary slightly between FreeType versions
+	float maxDifferentFraction = 0.f;
+	
+	// aDataPath is the folder with the images and fonts folders
+	static std::vector<RenderScene> sCreateAll( const of::filesystem::path& aDataPath );
+	
+	static RenderScene sCreateFillRules();
+	static RenderScene sCreateStrokes();
+	static RenderScene sCreateImages( const of::filesystem::path& aDataPath );
+	static RenderScene sCreateText( const of::filesystem::path& aDataPath );
+};
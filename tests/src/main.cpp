@@ -0,0 +1,22 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofApp.h"
+
+//========================================================================
+// renders the test documents with the software renderer and compares them to the references
+// in bin/data/references. Exits with 1 when a test fails.
+// Run with --update to write the current renders as the new references.
+int main( int argc, char** argv ){
+	
+	auto app = std::make_shared<ofApp>();
+	for( int i = 1; i < argc; i++ ) {
+		if( std::string( argv[i] ) == "--update" ) {
+			app->bUpdateReferences = true;
+		}
+	}
+	
+	auto window = std::make_shared<ofAppNoWindow>();
+	ofRunApp( window, app );
+	return ofRunMainLoop();
+
+}
@@ -0,0 +1,87 @@
+#include "ofApp.h"
+#include "ofxSvgSoftwareRenderer.h"
+#include "GroupTests.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	auto tscenes = RenderScene::sCreateAll( ofToDataPath( "", true ));
+	int numFailed = 0;
+	for( auto& tscene : tscenes ) {
+		if( !runTest( tscene )) {
+			numFailed++;
+		}
+	}
+	if( numFailed > 0 ) {
+		ofLogError("RenderTests") << numFailed << " of " << tscenes.size() << " tests failed";
+	} else {
+		ofLogNotice("RenderTests") << "all " << tscenes.size() << " tests passed";
+	}
+	numFailed += GroupTests::sRunAll();
+	ofExit( numFailed > 0 ? 1 : 0 );
+}
+
+//--------------------------------------------------------------
+bool ofApp::runTest( RenderScene& aScene ) {
+	ofx::svg::SoftwareRenderer trenderer;
+	trenderer.setBackgroundColor( ofFloatColor( 1.f, 1.f, 1.f, 1.f ));
+	ofPixels trender;
+	if( !trenderer.render( *aScene.root, aScene.viewRect, aScene.width, aScene.height, trender )) {
+		ofLogError("RenderTests") << aScene.name << " : render failed";
+		return false;
+	}
+	
+	auto treferencePath = ofToDataPath( "references/" + aScene.name + ".png", true );
+	if( bUpdateReferences ) {
+		ofSaveImage( trender, treferencePath );
+		ofLogNotice("RenderTests") << aScene.name << " : updated the reference";
+		return true;
+	}
+	
+	ofPixels treference;
+	if( !ofLoadImage( treference, treferencePath )) {
+		ofLogError("RenderTests") << aScene.name << " : unable to load the reference " << treferencePath;
+		return false;
+	}
+	treference.setImageType( OF_IMAGE_COLOR_ALPHA );
+	if( treference.getWidth() != trender.getWidth() || treference.getHeight() != trender.getHeight() ) {
+		ofLogError("RenderTests") << aScene.name << " : the reference is " << treference.getWidth() << "x" << treference.getHeight() << ", the render is " << trender.getWidth() << "x" << trender.getHeight();
+		return false;
+	}
+	
+	ofPixels tdiff;
+	tdiff.allocate( trender.getWidth(), trender.getHeight(), OF_IMAGE_COLOR_ALPHA );
+	std::size_t numDifferent = 0;
+	int maxDifference = 0;
+	const unsigned char* trenderData = trender.getData();
+	const unsigned char* treferenceData = treference.getData();
+	unsigned char* tdiffData = tdiff.getData();
+	std::size_t numPixels = trender.getWidth() * trender.getHeight();
+	for( std::size_t i = 0; i < numPixels; i++ ) {
+		int tdifference = 0;
+		for( int k = 0; k < 4; k++ ) {
+			tdifference = std::max( tdifference, std::abs( (int)trenderData[i*4+k] - (int)treferenceData[i*4+k] ));
+		}
+		maxDifference = std::max( maxDifference, tdifference );
+		bool bDifferent = tdifference > aScene.tolerance;
+		if( bDifferent ) {
+			numDifferent++;
+		}
+		// the reference faded out, with the different pixels in red
+		unsigned char tgray = (unsigned char)( 191 + treferenceData[i*4] / 4 );
+		tdiffData[i*4+0] = bDifferent ? 255 : tgray;
+		tdiffData[i*4+1] = bDifferent ? 0 : tgray;
+		tdiffData[i*4+2] = bDifferent ? 0 : tgray;
+		tdiffData[i*4+3] = 255;
+	}
+	
+	bool bPassed = (float)numDifferent <= aScene.maxDifferentFraction * (float)numPixels;
+	if( bPassed ) {
+		ofLogNotice("RenderTests") << aScene.name << " : passed, " << numDifferent << " pixels different, max difference " << maxDifference;
+	} else {
+		ofLogError("RenderTests") << aScene.name << " : failed, " << numDifferent << " of " << numPixels << " pixels differ by more than " << aScene.tolerance << ", max difference " << maxDifference;
+		ofDirectory::createDirectory( ofToDataPath( "output", true ), false, true );
+		ofSaveImage( trender, ofToDataPath( "output/" + aScene.name + ".png", true ));
+		ofSaveImage( tdiff, ofToDataPath( "output/" + aScene.name + "_diff.png", true ));
+	}
+	return bPassed;
+}
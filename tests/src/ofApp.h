@@ -0,0 +1,17 @@
+#pragma once
+
+#include "ofMain.h"
+#include "RenderScenes.h"
+
+class ofApp : public ofBaseApp{
+	public:
+		void setup();
+		
+		// writes the renders to the references folder instead of comparing them
+		bool bUpdateReferences = false;
+	
+	protected:
+		// returns false when the render does not match the reference. The render and a diff image are
+		// saved to the output folder, the diff marks the pixels that are different in red.
+		bool runTest( RenderScene& aScene );
+};